@@ -0,0 +1,68 @@
+#pragma once
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <vector>
+
+// Plugin-wide analysis worker pool shared by all analyzer instances
+// Characteristics:
+// - Small fixed pool sized to the available cores, so the thread count stays constant
+//   however many analyzers exist
+// - Coalescing jobs: a job already pending is not queued again, it picks up the latest
+//   data when it runs (stale frames are replaced, never queued)
+// - submit() is wait-free for the audio thread (flag + unlocked notify; the workers
+//   also wake on a short timeout, so a missed notify only delays one job)
+// - A job never runs on two workers at once
+// - Workers start with the first registered job and are joined when the last one is
+//   removed, so no threads are left (or joined) when the plugin library is unloaded
+class AnalysisScheduler {
+public:
+    static const int MAX_THREADS = 4;
+
+    class Job {
+    public:
+        virtual ~Job() {}
+        virtual void run() = 0;  // Worker thread
+
+    private:
+        friend class AnalysisScheduler;
+        std::atomic<bool> pending{false};
+        bool running = false;  // Guarded by the scheduler mutex
+    };
+
+    static AnalysisScheduler& instance();
+
+    // Any non-audio thread: register/unregister a job (remove waits for a running job to
+    // finish, and for the workers to exit when it was the last job)
+    void add(Job* job);
+    void remove(Job* job);
+
+    // Audio thread: request one run of the job
+    inline void submit(Job* job) {
+        if (!job->pending.exchange(true, std::memory_order_acq_rel)) {
+            workCV.notify_one();
+        }
+    }
+
+    int getNumThreads() const { return (int)workers.size(); }
+
+private:
+    std::vector<std::thread> workers;
+    std::vector<Job*> jobs;
+    size_t nextJob = 0;  // Round-robin start so busy analyzers cannot starve the others
+    std::mutex lifecycleMutex;  // Serializes add/remove, held while workers start or are joined
+    std::mutex mutex;
+    std::condition_variable workCV;
+    std::condition_variable idleCV;
+    bool stop = false;
+
+    AnalysisScheduler();
+    ~AnalysisScheduler();
+    AnalysisScheduler(const AnalysisScheduler&) = delete;
+    AnalysisScheduler& operator=(const AnalysisScheduler&) = delete;
+
+    void startWorkers();
+    Job* takePendingJob();
+    void workerThreadFunc();
+};
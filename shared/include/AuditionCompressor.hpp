@@ -0,0 +1,88 @@
+#pragma once
+#include "rack.hpp"
+#include "CompressorEngine.hpp"
+
+using namespace rack;
+using simd::float_4;
+
+// Four-engine audition compressor (A/B all C1-COMP types on the same input)
+// Characteristics:
+// - Runs VCA, FET, Optical and Vari-Mu side by side, one engine per float_4 lane
+// - Lane order matches C1COMP::CompressorType: 0 = VCA, 1 = FET, 2 = Optical, 3 = Vari-Mu
+// - Shared vectorized gain computer; per-lane detector, knee, ballistics and coloration
+// - Every lane's detector keeps running, so switching the audible lane has no warm-up
+// - Lane changes crossfade over 5ms to avoid clicks
+class AuditionCompressor : public CompressorEngine {
+public:
+    static const int NUM_LANES = 4;
+
+    AuditionCompressor();
+
+    // CompressorEngine interface implementation (per-lane mapping mirrors each engine class)
+    void setSampleRate(float sr) override;
+    void setThreshold(float db) override;
+    void setRatio(float r) override;
+    void setAttack(float ms) override;
+    void setRelease(float ms) override;
+    void setMakeup(float db) override;
+    void setAutoRelease(bool enable) override;
+    void setKnee(float db) override;
+
+    void processStereo(float inL, float inR, float* outL, float* outR) override;
+    void processStereoWithKey(float inL, float inR, float keyLevel, float* outL, float* outR) override;
+    float getGainReduction() const override { return -gainReductionDb[activeLane]; }
+    const char* getTypeName() const override { return "Audition (4 engines)"; }
+
+    // Audible lane selection (0-3, see lane order above)
+    void setActiveLane(int lane);
+    int getActiveLane() const { return activeLane; }
+
+    // Gain reduction of any lane in dB (negative value), for side-by-side metering
+    float getLaneGainReduction(int lane) const;
+
+private:
+    // Parameters (one lane per engine)
+    float sampleRate;
+    float_4 thresholdDb;
+    float_4 ratio;
+    float_4 attackMs;
+    float_4 releaseMs;
+    float_4 attackCoeff;
+    float_4 releaseCoeff;
+    float_4 rmsCoeff;
+    float_4 makeupGain;
+    float_4 kneeWidth;
+    bool autoReleaseMode;
+
+    // Last raw control values (coefficients are only recalculated when these change)
+    float lastAttackMs;
+    float lastReleaseMs;
+
+    // Detector state
+    float_4 gainReductionDb;
+    float_4 rmsState;    // RMS detectors (FET, Optical, Vari-Mu lanes)
+    float_4 optoState;   // Opto-resistor state (Optical lane)
+    float_4 tubeStateL;  // Tube grid state, left (Vari-Mu lane)
+    float_4 tubeStateR;  // Tube grid state, right (Vari-Mu lane)
+
+    // Lane output selection
+    int activeLane;
+    float_4 laneGain;        // Smoothed one-hot output weights
+    float_4 laneGainTarget;
+    float laneFadeCoeff;
+
+    // Lane masks and engine constants
+    float_4 vcaLane;
+    float_4 optoLane;
+    float_4 variMuLane;
+    static constexpr float optoDecay = 0.95f;
+    static constexpr float fetDistortionAmount = 0.15f;
+    static constexpr float tubeSaturation = 0.25f;
+    static constexpr float tubeAsymmetry = 0.1f;
+
+    // Helpers
+    void recalculateCoefficients();
+    void processLanes(float_4 inputDb, bool keyed, float inL, float inR, float* outL, float* outR);
+    float_4 dbToLin4(float_4 db) const { return simd::exp(db * (float)(M_LN10 / 20.0)); }
+    float_4 msToCoeff(float_4 ms) const { return simd::exp(-1000.0f / (ms * sampleRate)); }
+};
@@ -2,71 +2,218 @@
 #include "rack.hpp"
 #include <dsp/fft.hpp>
 #include <cmath>
-#include <thread>
 #include <mutex>
-#include <condition_variable>
 #include <atomic>
+#include <cstdint>
+#include <vector>
+#include "AnalysisScheduler.hpp"
 
 using namespace rack;
+using simd::float_4;
 
-class EqAnalysisEngine {
+// FFT jobs run on the plugin-wide AnalysisScheduler pool
+// FFT size, window and overlap are set from any thread and applied by the worker
+// at the start of its next job (FFT setup, buffers and window table are rebuilt there)
+// Optional pre/post capture: the EQ input travels through the same ring and job as the
+// output, giving input, output and difference (output / input) spectra from one window
+// Optional multirate mode: the worker decimates the ring by 4 and 16 (halfband cascade)
+// and runs the same FFT size on each rate, low bands are drawn from the finest rate that
+// covers them (16x finer bins below ~1kHz at 48kHz for about 1.3x the FFT work)
+class EqAnalysisEngine : public AnalysisScheduler::Job {
 public:
-    static const int BUFFER_SIZE = 2048;
+    static const int MIN_FFT_SIZE = 1024;
+    static const int MAX_FFT_SIZE = 8192;
+    static const int DEFAULT_FFT_SIZE = 2048;
+    static const int NUM_FFT_SIZES = 4;         // 1024, 2048, 4096, 8192
+    static const int NUM_OVERLAPS = 3;          // None, 50%, 75% (hop = size >> overlap)
+    static const int DEFAULT_OVERLAP = 1;
+    static const int RING_SIZE = 2 * MAX_FFT_SIZE;  // Power of two, leaves room for the worker to lag behind
     static const int DISPLAY_BANDS = 128;
+    static const int NUM_RATE_LEVELS = 3;       // Native, /4, /16 (multirate mode)
+    static const int DECIMATION_STAGES = 4;     // Halfband /2 stages, level L taps stage 2L - 1
+    static const int HALFBAND_LENGTH = 31;
+    static const int DECIMATED_RING_SIZE = MAX_FFT_SIZE;  // Power of two, worker only
+    static constexpr float LEVEL_MAX_FREQ = 0.35f;   // Usable band of a decimated level (x its rate)
+    static constexpr float PEAK_HOLD_TIME = 0.5f;    // Seconds a peak is held before it decays
+    static constexpr float PEAK_DECAY_RATE = 0.98f;  // Peak decay per 1/60 s once released
     static constexpr float MIN_FREQ = 20.0f;
     static constexpr float MAX_FREQ = 22000.0f;
     static constexpr float MIN_LOG_FREQ = 1.30103f;
     static constexpr float MAX_LOG_FREQ = 4.342423f;
 
+    enum Window {
+        WINDOW_HANN,
+        WINDOW_BLACKMAN_HARRIS,
+        NUM_WINDOWS
+    };
+
+    // Output (post-EQ) and input (pre-EQ) channels
+    enum Channel {
+        LEFT,
+        RIGHT,
+        PRE_LEFT,
+        PRE_RIGHT,
+        NUM_CHANNELS
+    };
+
+    // Fractional-octave smoothing of the display bands (off = loudest bin per band)
+    enum Smoothing {
+        SMOOTHING_OFF,
+        SMOOTHING_THIRD,
+        SMOOTHING_SIXTH,
+        SMOOTHING_TWELFTH,
+        NUM_SMOOTHINGS
+    };
+
+    static int fftSizeForIndex(int index) { return MIN_FFT_SIZE << index; }
+
     EqAnalysisEngine();
-    ~EqAnalysisEngine();
+    ~EqAnalysisEngine() override;
+
+    // Audio thread: wait-free, writes one frame into the ring (no locks, no bulk copies)
+    // The input (pre) samples are only analysed while pre capture is enabled
+    inline void addSample(float left, float right, float preLeft = 0.0f, float preRight = 0.0f) {
+        uint32_t pos = writePos.load(std::memory_order_relaxed);
+        uint32_t index = pos & (RING_SIZE - 1);
+        ring[LEFT][index] = left;
+        ring[RIGHT][index] = right;
+        ring[PRE_LEFT][index] = preLeft;
+        ring[PRE_RIGHT][index] = preRight;
+        writePos.store(pos + 1, std::memory_order_release);
+        if (++frameIndex >= hopSize.load(std::memory_order_relaxed)) {
+            frameIndex = 0;
+            if (analysisActive.load(std::memory_order_relaxed)) {
+                scheduler.submit(this);
+            }
+        }
+    }
 
-    void addSample(float left, float right);
     void setSampleRate(float sampleRate) { this->sampleRate = sampleRate; }
 
-    // Get spectrum data for rendering (thread-safe)
-    const float* getLeftSpectrum() const { return leftLogSpectrum; }
-    const float* getRightSpectrum() const { return rightLogSpectrum; }
-    const float* getLeftPeakHold() const { return leftPeakHold; }
-    const float* getRightPeakHold() const { return rightPeakHold; }
+    // Any thread, wait-free: FFT size (power of two, 1024-8192), Window, overlap index
+    void setAnalysisSettings(int fftSize, int window, int overlap);
+
+    // Any thread, wait-free: Smoothing mode, applied by the next job
+    void setSmoothing(int smoothing) { smoothingSetting.store(clamp(smoothing, 0, NUM_SMOOTHINGS - 1)); }
+
+    // Any thread, wait-free: multirate analysis (decimated levels for low-frequency detail)
+    void setMultirate(bool enabled) { multirateSetting.store(enabled); }
+
+    // Any thread, wait-free: analyse the input (pre) channels as well (second FFT per job)
+    void setPreCapture(bool enabled) { preCapture.store(enabled); }
+
+    // UI thread, once per frame: apply display ballistics (averaging, peak hold and decay)
+    // to the latest raw spectrum, timed by the frame timestamp (seconds) so the display
+    // behaves the same at any analysis rate or frame rate
+    void updateDisplay(double time);
+    void setAveragingTime(float seconds) { averagingTime = std::max(seconds, 0.0f); }  // 0 = off
+
+    // Display data for rendering (UI thread, valid after updateDisplay)
+    const float* getLeftSpectrum() const { return display[LEFT]; }
+    const float* getRightSpectrum() const { return display[RIGHT]; }
+    const float* getLeftPeakHold() const { return peakHold[LEFT]; }
+    const float* getRightPeakHold() const { return peakHold[RIGHT]; }
+    const float* getLeftPreSpectrum() const { return display[PRE_LEFT]; }
+    const float* getRightPreSpectrum() const { return display[PRE_RIGHT]; }
+    const float* getDifferenceDb() const { return differenceDb; }  // Output / input, L+R power (0 dB where silent)
 
-    // Copy spectrum data (thread-safe)
+    // Copy display data (UI thread)
     void getSpectrumData(float* leftSpectrum, float* rightSpectrum,
                         float* leftPeaks = nullptr, float* rightPeaks = nullptr);
 
-    // Thread control (public for external start/stop)
-    void startWorkerThread();
-    void stopWorkerThread();
+    // Job scheduling (public for external start/stop, wait-free)
+    void startAnalysis() { analysisActive.store(true); }
+    void stopAnalysis() { analysisActive.store(false); }
+
+    // Worker thread: analyse the latest window in the ring
+    void run() override;
 
 private:
     float sampleRate = 44100.0f;
-    float leftBuffer[BUFFER_SIZE] = {};
-    float rightBuffer[BUFFER_SIZE] = {};
-    int bufferIndex = 0;
+    // Single-producer/single-consumer ring: the audio thread only advances writePos,
+    // the worker copies the latest fftSize frames behind it
+    float ring[NUM_CHANNELS][RING_SIZE] = {};
+    std::atomic<uint32_t> writePos{0};
     int frameIndex = 0;
-    int frameCount = 1024;
-    dsp::RealFFT fft;
-    float fftInput[BUFFER_SIZE] = {};
-    float fftOutput[BUFFER_SIZE * 2] = {};
-    float spectrum[BUFFER_SIZE / 2] = {};
-    float leftLogSpectrum[DISPLAY_BANDS] = {};
-    float rightLogSpectrum[DISPLAY_BANDS] = {};
-    float leftPeakHold[DISPLAY_BANDS] = {};
-    float rightPeakHold[DISPLAY_BANDS] = {};
-    float leftPeakTimer[DISPLAY_BANDS] = {};
-    float rightPeakTimer[DISPLAY_BANDS] = {};
-    std::thread workerThread;
-    std::mutex bufferMutex;
+    std::atomic<int> hopSize{DEFAULT_FFT_SIZE >> DEFAULT_OVERLAP};
+    std::atomic<bool> preCapture{false};
+
+    // Requested settings (any thread) and the ones the worker buffers are built for
+    std::atomic<int> fftSizeSetting{DEFAULT_FFT_SIZE};
+    std::atomic<int> windowSetting{WINDOW_HANN};
+    std::atomic<int> smoothingSetting{SMOOTHING_OFF};
+    std::atomic<bool> multirateSetting{false};
+    int fftSize = 0;
+    int window = -1;
+
+    // Stereo pairs are batched: both channels windowed, then two real FFTs back to back
+    // (RealFFT already runs as a half-size complex transform, so packing L + jR into one
+    // complex FFT saves no transform work)
+    // Buffers sized on settings changes; new[]-backed vectors meet PFFFT's 16-byte alignment
+    dsp::RealFFT* fft = nullptr;
+    std::vector<float> windowTable;
+    float windowGain = 1.0f;  // Sum of the window (coherent gain), keeps sine levels independent of the window
+    std::vector<float> fftInput[2];
+    std::vector<float> fftOutput[2];
+    std::vector<float> workerBuffers[NUM_CHANNELS];
+    std::vector<float> bins[NUM_CHANNELS];
+
+    // Display band -> contiguous FFT bin range [bandBinStart, bandBinEnd) per rate level,
+    // depends only on the sample rate (bins map monotonically to bands, empty bands have
+    // start == end), bandLevel is the rate level each band is drawn from
+    int bandBinStart[NUM_RATE_LEVELS][DISPLAY_BANDS] = {};
+    int bandBinEnd[NUM_RATE_LEVELS][DISPLAY_BANDS] = {};
+    int bandLevel[DISPLAY_BANDS] = {};
+    float bandMapSampleRate = 0.0f;
+
+    // Smoothing: bin range [smoothBinStart, smoothBinEnd) of the fractional-octave window
+    // around each band centre, averaged in O(1) per band from a prefix sum of bin powers
+    int smoothing = SMOOTHING_OFF;
+    int smoothBinStart[NUM_RATE_LEVELS][DISPLAY_BANDS] = {};
+    int smoothBinEnd[NUM_RATE_LEVELS][DISPLAY_BANDS] = {};
+    std::vector<double> powerPrefix;
+
+    // Multirate (worker only): halfband cascade fed from the ring, decimated rings for
+    // levels 1 and 2 (allocated when first enabled), level L is re-analysed once it has
+    // a new hop of samples (its bands are kept in between)
+    bool multirate = false;
+    uint32_t decimationReadPos = 0;   // Ring position the cascade has consumed up to
+    uint32_t decimationCount = 0;     // Cascade input count, its bits select the stages that run
+    float decimationHistory[NUM_CHANNELS][DECIMATION_STAGES][2 * HALFBAND_LENGTH] = {};
+    int decimationHistoryPos[DECIMATION_STAGES] = {};
+    std::vector<float> decimatedRing[NUM_RATE_LEVELS - 1][NUM_CHANNELS];
+    uint32_t decimatedPos[NUM_RATE_LEVELS - 1] = {};
+    uint32_t levelAnalysedPos[NUM_RATE_LEVELS - 1] = {};
+    int analysedChannels = 0;
+
+    float bands[NUM_CHANNELS][DISPLAY_BANDS] = {};  // Worker scratch
+
+    // Latest raw band magnitudes, published by the worker under spectrumMutex
+    float raw[NUM_CHANNELS][DISPLAY_BANDS] = {};
     std::mutex spectrumMutex;
-    std::condition_variable workerCV;
-    std::atomic<bool> workerStop{false};
-    std::atomic<bool> newDataReady{false};
-    float leftWorkerBuffer[BUFFER_SIZE] = {};
-    float rightWorkerBuffer[BUFFER_SIZE] = {};
-    bool workerRunning = false;
-
-    void sendToWorker();
-    void workerThreadFunc();
-    void processFFTWorker(float* leftInputBuffer, float* rightInputBuffer);
-    void mapToLogScale(bool isLeftChannel);
-};
\ No newline at end of file
+
+    // Display stage (UI thread only)
+    float display[NUM_CHANNELS][DISPLAY_BANDS] = {};
+    float peakHold[NUM_CHANNELS][DISPLAY_BANDS] = {};
+    float peakAge[NUM_CHANNELS][DISPLAY_BANDS] = {};  // Seconds since the peak was set
+    float differenceDb[DISPLAY_BANDS] = {};
+    float averagingTime = 0.0f;
+    double lastDisplayTime = -1.0;
+    AnalysisScheduler& scheduler;
+    std::atomic<bool> analysisActive{true};
+
+    void configure(int size, int windowType);
+    bool readLatestWindow(int numChannels);
+    void resetDecimation();
+    void decimateNewSamples(int numChannels);
+    void readDecimatedWindow(int level, int numChannels);
+    void analysePair(int leftChannel, int level);
+    void buildBandMap(float rate);
+    void buildSmoothingMap(int level, float rate);
+    void computeMagnitudes(const float* spectrum, float* binsOut);
+    void mapToLogScale(const float* spectrum, float* bandOut, int level);
+    void smoothToLogScale(const float* spectrum, float* bandOut, int level);
+    void publishBands(int numChannels);
+    static void applyBallistics(const float* raw, float* display, float* peakHold, float* peakAge,
+                                float dt, float averaging);
+};
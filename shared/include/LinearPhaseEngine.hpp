@@ -0,0 +1,125 @@
+#pragma once
+#include "rack.hpp"
+#include <dsp/fft.hpp>
+#include <cmath>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+using namespace rack;
+using simd::float_4;
+
+// Linear-phase EQ engine (symmetric FIR applied by partitioned FFT convolution)
+// Characteristics:
+// - The magnitude response of up to four SVF sections is turned into a zero-phase
+//   spectrum, transformed to a Blackman-windowed symmetric FIR on a worker thread
+// - Uniformly partitioned overlap-save convolution: one FFT and one inverse FFT per
+//   partition, a frequency-domain delay line multiplied against the filter partitions
+// - Triple-buffered filters picked up at block boundaries, crossfaded over one block
+// - Latency = FIR group delay (LATENCY_TAPS) + one partition
+// - Float_4 interface matching C1EQ's voice groups: [L(2g), R(2g), L(2g+1), R(2g+1)]
+class LinearPhaseEngine {
+public:
+    static const int FIR_LENGTH = 8192;              // Filter length (8191 symmetric taps + 1 zero)
+    static const int LATENCY_TAPS = FIR_LENGTH / 2 - 1;
+    static const int MAX_GROUPS = 8;
+    static const int MAX_LANES = MAX_GROUPS * 4;
+    static const int NUM_SECTIONS = 4;
+    static const int NUM_PARTITION_SIZES = 5;        // 64, 128, 256, 512, 1024
+    static const int MIN_PARTITION_SIZE = 64;
+    static const int MAX_PARTITION_SIZE = 1024;
+    static const int DEFAULT_PARTITION_SIZE = 256;
+
+    // Trapezoidal SVF section (same coefficients as C1EQ's bands):
+    // H(s) = m0 + (m1 s + m2) / (s^2 + k s + 1), with s prewarped by g = tan(pi fc)
+    struct Section {
+        float g = 0.0f;
+        float k = 1.0f;
+        float m0 = 1.0f;
+        float m1 = 0.0f;
+        float m2 = 0.0f;
+    };
+
+    LinearPhaseEngine();
+    ~LinearPhaseEngine();
+
+    // UI thread: takes effect with the next filter design (restarts the convolution)
+    void setPartitionSize(int size);
+    int getPartitionSize() const { return partitionSizeSetting.load(); }
+    int getLatency() const { return LATENCY_TAPS + getPartitionSize(); }
+    int getActiveLatency() const { return LATENCY_TAPS + partitionSize; }  // Audio thread: running convolution
+    static int partitionSizeForIndex(int index) { return MIN_PARTITION_SIZE << index; }
+
+    // Audio thread: hand the current sections to the worker (false = worker busy, retry later)
+    bool requestDesign(const Section* sections);
+
+    // Audio thread: clear convolution state (all groups or one voice group)
+    void reset();
+    void resetGroup(int group);
+
+    // Audio thread: one sample of one voice group; the output is delayed by getLatency()
+    inline float_4 process(int group, float_4 x) {
+        inputBlock[group][blockPos] = x;
+        return outputBlock[group][blockPos];
+    }
+
+    // Audio thread: call once per sample after the groups, runs the FFT work at block ends
+    inline void advance(int groups) {
+        if (++blockPos >= partitionSize) {
+            blockPos = 0;
+            processBlock(groups);
+        }
+    }
+
+private:
+    struct Filter {
+        int partitionSize = 0;
+        int numPartitions = 0;
+        alignas(16) float spectra[2 * FIR_LENGTH] = {};  // Partition spectra, pre-scaled by 1 / FFT length
+    };
+
+    // Audio thread state
+    int partitionSize = DEFAULT_PARTITION_SIZE;
+    int numPartitions = FIR_LENGTH / DEFAULT_PARTITION_SIZE;
+    int blockPos = 0;
+    int fdlPos = 0;
+    int active = -1;  // Filter in use (-1 = none designed yet, output silent)
+    float_4 inputBlock[MAX_GROUPS][MAX_PARTITION_SIZE] = {};
+    float_4 outputBlock[MAX_GROUPS][MAX_PARTITION_SIZE] = {};
+    alignas(16) float history[MAX_LANES][MAX_PARTITION_SIZE] = {};
+    alignas(16) float fdl[MAX_LANES][2 * FIR_LENGTH] = {};  // Input spectra, numPartitions slots per lane
+    alignas(16) float frame[2 * MAX_PARTITION_SIZE] = {};
+    alignas(16) float spectrum[2 * MAX_PARTITION_SIZE] = {};
+    alignas(16) float accumulator[2 * MAX_PARTITION_SIZE] = {};
+    alignas(16) float convolved[2 * MAX_PARTITION_SIZE] = {};
+    alignas(16) float faded[2 * MAX_PARTITION_SIZE] = {};
+    dsp::RealFFT* blockFFT[NUM_PARTITION_SIZES] = {};
+
+    // Filters shared with the worker (worker fills one the audio thread is not using)
+    Filter filters[3];
+    std::atomic<int> published{-1};
+
+    // Worker state
+    std::thread workerThread;
+    std::mutex jobMutex;
+    std::condition_variable jobCV;
+    std::atomic<bool> workerStop{false};
+    bool jobPending = false;
+    bool haveSections = false;
+    Section jobSections[NUM_SECTIONS];
+    std::atomic<int> partitionSizeSetting{DEFAULT_PARTITION_SIZE};
+    int recentFilters[2] = {-1, -1};  // Last two published filters (active and fading)
+    dsp::RealFFT* designFFT = nullptr;
+    dsp::RealFFT* partitionFFT[NUM_PARTITION_SIZES] = {};
+    alignas(16) float designSpectrum[2 * FIR_LENGTH] = {};
+    alignas(16) float designImpulse[2 * FIR_LENGTH] = {};
+    alignas(16) float designFrame[2 * MAX_PARTITION_SIZE] = {};
+    alignas(16) float taps[FIR_LENGTH] = {};
+
+    static int partitionIndex(int size);
+    void processBlock(int groups);
+    void convolve(const Filter& filter, int lane, float* output);
+    void workerThreadFunc();
+    void design(const Section* sections, int size, Filter& filter);
+};
@@ -0,0 +1,91 @@
+#include "AnalysisScheduler.hpp"
+#include <algorithm>
+#include <chrono>
+
+AnalysisScheduler& AnalysisScheduler::instance() {
+    static AnalysisScheduler scheduler;
+    return scheduler;
+}
+
+AnalysisScheduler::AnalysisScheduler() {}
+
+AnalysisScheduler::~AnalysisScheduler() {
+    // Runs at library unload (on Windows under the loader lock, where joining deadlocks)
+    // The workers already exited with the last job; detach leftovers rather than join
+    for (std::thread& worker : workers) {
+        if (worker.joinable()) {
+            worker.detach();
+        }
+    }
+}
+
+void AnalysisScheduler::startWorkers() {
+    // Half the cores (the other half belong to the audio engine), at least one
+    int cores = (int)std::thread::hardware_concurrency();
+    int maxThreads = MAX_THREADS;  // Local copy: std::min takes references (no ODR use)
+    int threads = std::max(1, std::min(maxThreads, cores / 2));
+    for (int i = 0; i < threads; i++) {
+        workers.push_back(std::thread(&AnalysisScheduler::workerThreadFunc, this));
+    }
+}
+
+void AnalysisScheduler::add(Job* job) {
+    std::lock_guard<std::mutex> lifecycleLock(lifecycleMutex);
+    std::lock_guard<std::mutex> lock(mutex);
+    if (std::find(jobs.begin(), jobs.end(), job) == jobs.end()) {
+        jobs.push_back(job);
+    }
+    if (workers.empty()) {
+        startWorkers();  // First job: the workers wait on mutex until it is released
+    }
+}
+
+void AnalysisScheduler::remove(Job* job) {
+    std::lock_guard<std::mutex> lifecycleLock(lifecycleMutex);
+    std::unique_lock<std::mutex> lock(mutex);
+    jobs.erase(std::remove(jobs.begin(), jobs.end(), job), jobs.end());
+    idleCV.wait(lock, [job] { return !job->running; });
+    if (!jobs.empty() || workers.empty()) return;
+
+    // Last job gone: stop and join the workers (restarted by the next add)
+    stop = true;
+    lock.unlock();
+    workCV.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+    lock.lock();
+    stop = false;
+    nextJob = 0;
+}
+
+AnalysisScheduler::Job* AnalysisScheduler::takePendingJob() {
+    size_t count = jobs.size();
+    for (size_t i = 0; i < count; i++) {
+        size_t index = (nextJob + i) % count;
+        Job* job = jobs[index];
+        if (!job->running && job->pending.exchange(false, std::memory_order_acq_rel)) {
+            nextJob = index + 1;
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+void AnalysisScheduler::workerThreadFunc() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stop) {
+        Job* job = takePendingJob();
+        if (!job) {
+            workCV.wait_for(lock, std::chrono::milliseconds(20));
+            continue;
+        }
+        job->running = true;
+        lock.unlock();
+        job->run();
+        lock.lock();
+        job->running = false;
+        idleCV.notify_all();
+    }
+}
@@ -0,0 +1,190 @@
+#include "AuditionCompressor.hpp"
+
+AuditionCompressor::AuditionCompressor() {
+    sampleRate = 44100.0f;  // Default, will be overridden by setSampleRate()
+
+    // Engine defaults (see VCACompressor, FETCompressor, OpticalCompressor, VariMuCompressor)
+    thresholdDb = -18.0f;
+    ratio = float_4(4.0f, 4.0f, 3.0f, 2.0f);
+    attackMs = float_4(10.0f, 0.1f, 10.0f, 20.0f);
+    releaseMs = float_4(200.0f, 50.0f, 500.0f, 800.0f);
+    makeupGain = 1.0f;
+    kneeWidth = float_4(0.0f, 0.0f, 6.0f, 12.0f);
+    autoReleaseMode = false;
+    lastAttackMs = -1.0f;
+    lastReleaseMs = -1.0f;
+
+    gainReductionDb = 0.0f;
+    rmsState = 0.0f;
+    optoState = 0.0f;
+    tubeStateL = 0.0f;
+    tubeStateR = 0.0f;
+
+    float_4 laneIndex = float_4(0.0f, 1.0f, 2.0f, 3.0f);
+    vcaLane = (laneIndex == 0.0f);
+    optoLane = (laneIndex == 2.0f);
+    variMuLane = (laneIndex == 3.0f);
+
+    activeLane = 0;
+    laneGainTarget = float_4(1.0f, 0.0f, 0.0f, 0.0f);
+    laneGain = laneGainTarget;
+
+    recalculateCoefficients();
+}
+
+void AuditionCompressor::setSampleRate(float sr) {
+    if (sr > 0.0f && sr != sampleRate) {
+        sampleRate = sr;
+        recalculateCoefficients();
+    }
+}
+
+void AuditionCompressor::setThreshold(float db) {
+    thresholdDb = db;
+}
+
+void AuditionCompressor::setRatio(float r) {
+    r = std::max(1.0f, r);
+    // Optical caps at 10:1, Vari-Mu at 6:1
+    ratio = float_4(r, r, std::min(r, 10.0f), std::min(r, 6.0f));
+}
+
+void AuditionCompressor::setAttack(float ms) {
+    if (ms == lastAttackMs) return;
+    lastAttackMs = ms;
+    // FET maps 0.1-30ms to 20µs-800µs, Optical min 10ms, Vari-Mu min 20ms
+    attackMs = float_4(ms, 0.02f + (ms / 30.0f) * 0.78f, std::max(10.0f, ms), std::max(20.0f, ms));
+    attackCoeff = msToCoeff(attackMs);
+}
+
+void AuditionCompressor::setRelease(float ms) {
+    if (ms == lastReleaseMs) return;
+    lastReleaseMs = ms;
+    // FET releases 3x faster, Vari-Mu 2x slower
+    releaseMs = float_4(ms, ms / 3.0f, ms, ms * 2.0f);
+    releaseCoeff = msToCoeff(releaseMs);
+}
+
+void AuditionCompressor::setMakeup(float db) {
+    makeupGain = dbToLin(db);
+}
+
+void AuditionCompressor::setAutoRelease(bool enable) {
+    autoReleaseMode = enable;
+}
+
+void AuditionCompressor::setKnee(float db) {
+    // -1 or negative = use each engine's default knee
+    kneeWidth = (db < 0.0f) ? float_4(0.0f, 0.0f, 6.0f, 12.0f) : float_4(db);
+}
+
+void AuditionCompressor::setActiveLane(int lane) {
+    activeLane = clamp(lane, 0, NUM_LANES - 1);
+    laneGainTarget = (float_4(0.0f, 1.0f, 2.0f, 3.0f) == float_4((float)activeLane)) & float_4(1.0f);
+}
+
+float AuditionCompressor::getLaneGainReduction(int lane) const {
+    return -gainReductionDb[clamp(lane, 0, NUM_LANES - 1)];
+}
+
+void AuditionCompressor::recalculateCoefficients() {
+    attackCoeff = msToCoeff(attackMs);
+    releaseCoeff = msToCoeff(releaseMs);
+
+    // RMS averaging per lane: VCA is peak (unused), FET 5ms, Optical 10ms, Vari-Mu 20ms
+    rmsCoeff = simd::exp(-1.0f / (float_4(0.001f, 0.005f, 0.010f, 0.020f) * sampleRate));
+
+    // 5ms crossfade between lanes
+    laneFadeCoeff = 1.0f - std::exp(-1.0f / (0.005f * sampleRate));
+}
+
+void AuditionCompressor::processStereo(float inL, float inR, float* outL, float* outR) {
+    // Detection: VCA lane uses stereo peak, the others use RMS with their own averaging time
+    float peakLevel = std::max(std::abs(inL), std::abs(inR));
+    float inputSquared = 0.5f * (inL * inL + inR * inR);
+    rmsState = rmsCoeff * rmsState + (1.0f - rmsCoeff) * inputSquared;
+
+    float_4 level = simd::ifelse(vcaLane, float_4(peakLevel), simd::sqrt(rmsState));
+    float_4 inputDb = 20.0f * simd::log10(simd::fmax(level, 1e-12f));
+
+    processLanes(inputDb, false, inL, inR, outL, outR);
+}
+
+void AuditionCompressor::processStereoWithKey(float inL, float inR, float keyLevel, float* outL, float* outR) {
+    // External key drives every lane directly (bypasses RMS, as in the single engines)
+    processLanes(float_4(linToDb(keyLevel)), true, inL, inR, outL, outR);
+}
+
+void AuditionCompressor::processLanes(float_4 inputDb, bool keyed, float inL, float inR, float* outL, float* outR) {
+    // Shared gain computer (hard/soft knee per lane)
+    float_4 overThreshold = inputDb - thresholdDb;
+    float_4 slope = 1.0f - 1.0f / ratio;
+    float_4 safeKnee = simd::fmax(kneeWidth, 1e-6f);
+    float_4 kneeGR = (overThreshold * overThreshold) / (2.0f * safeKnee) * slope;
+    float_4 aboveKneeGR = (kneeWidth * 0.5f) * slope + (overThreshold - kneeWidth) * slope;
+    float_4 hardGR = overThreshold * slope;
+    float_4 softGR = simd::ifelse(overThreshold < kneeWidth, kneeGR, aboveKneeGR);
+    float_4 targetGR = simd::ifelse(kneeWidth > 0.0f, softGR, hardGR);
+    targetGR = simd::ifelse(overThreshold > 0.0f, targetGR, float_4::zero());
+
+    // Opto-resistor simulation: slow decay state (Optical lane)
+    optoState = optoState * optoDecay + targetGR * (1.0f - optoDecay);
+
+    // Program-dependent release times per lane:
+    // VCA AUTO: 100-1200ms from GR delta, Optical: 0.5x-3x from GR depth,
+    // Vari-Mu AUTO: 1x-3x from GR depth (not applied with external key), FET: fixed
+    float_4 grNormalized = simd::fmin(gainReductionDb / 20.0f, 1.0f);
+    float_4 grDelta = simd::fmin(simd::fabs(targetGR - gainReductionDb) / 20.0f, 1.0f);
+    float_4 adaptiveMs = float_4(100.0f + 1100.0f * (1.0f - grDelta[0]),
+                                 releaseMs[1],
+                                 releaseMs[2] * (0.5f + grNormalized[2] * 2.5f),
+                                 releaseMs[3] * (1.0f + grNormalized[3] * 2.0f));
+    bool variMuAuto = autoReleaseMode && !keyed;
+    float_4 adaptiveLanes = (autoReleaseMode ? vcaLane : float_4::zero()) | optoLane |
+                            (variMuAuto ? variMuLane : float_4::zero());
+    float_4 releaseCoeffNow = simd::ifelse(adaptiveLanes, msToCoeff(adaptiveMs), releaseCoeff);
+    float_4 releaseTarget = simd::ifelse(optoLane, optoState, targetGR);
+
+    // Envelope follower (GR smoothing)
+    float_4 attackGR = attackCoeff * gainReductionDb + (1.0f - attackCoeff) * targetGR;
+    float_4 releaseGR = releaseCoeffNow * gainReductionDb + (1.0f - releaseCoeffNow) * releaseTarget;
+    gainReductionDb = simd::ifelse(targetGR > gainReductionDb, attackGR, releaseGR);
+
+    // Apply gain reduction + makeup
+    float_4 gain = dbToLin4(-gainReductionDb) * makeupGain;
+    float_4 compressedL = inL * gain;
+    float_4 compressedR = inR * gain;
+
+    // Coloration: FET soft clip (lane 1) and Vari-Mu tube saturation (lane 3)
+    float_4 fetMix = simd::fmin(gainReductionDb / 20.0f, 1.0f) * fetDistortionAmount;
+    float_4 tubeMix = simd::fmin(gainReductionDb / 12.0f, 1.0f) * tubeSaturation;
+    float_4 colorMix = float_4(0.0f, fetMix[1], 0.0f, tubeMix[3]);
+
+    auto colorLanes = [&](float_4 x, float_4& tubeState) {
+        // FET: 1 - exp(-(|x| - 1)) above unity
+        float_4 fetIn = x * 1.5f;
+        float_4 fetAbs = simd::fabs(fetIn);
+        float_4 fetSat = simd::ifelse(fetAbs > 1.0f, simd::sgn(fetIn) * (1.0f - simd::exp(1.0f - fetAbs)), fetIn);
+
+        // Vari-Mu: grid bias memory, cubic soft knee, exponential beyond ±1.5
+        float_4 tubeIn = x * 1.3f;
+        tubeState = tubeState * 0.999f + tubeIn * 0.001f;
+        float_4 biased = tubeIn + tubeAsymmetry * tubeState;
+        float_4 biasedAbs = simd::fabs(biased);
+        float_4 tubeSat = simd::ifelse(biasedAbs > 1.5f,
+                                       simd::sgn(biased) * (1.0f - simd::exp((1.5f - biasedAbs) * 0.5f)),
+                                       biased - (biased * biased * biased) / 9.0f);
+
+        float_4 colored = simd::ifelse(variMuLane, tubeSat, fetSat);
+        return x + colorMix * (colored - x);
+    };
+    float_4 lanesL = colorLanes(compressedL, tubeStateL);
+    float_4 lanesR = colorLanes(compressedR, tubeStateR);
+
+    // Lane selection with click-free crossfade
+    laneGain += (laneGainTarget - laneGain) * laneFadeCoeff;
+    float_4 mixL = lanesL * laneGain;
+    float_4 mixR = lanesR * laneGain;
+    *outL = mixL[0] + mixL[1] + mixL[2] + mixL[3];
+    *outR = mixR[0] + mixR[1] + mixR[2] + mixR[3];
+}
@@ -1,123 +1,399 @@
 #include "EqAnalysisEngine.hpp"
 
-EqAnalysisEngine::EqAnalysisEngine() : fft(BUFFER_SIZE) {
-    startWorkerThread();
+// 31-tap Kaiser-windowed halfband (beta 7), odd-offset taps from the centre outwards
+// Passband to 0.175 x input rate, ~70dB stopband from 0.325 (aliases stay above 0.35
+// x the output rate, the band a decimated level is used for)
+static const float HALFBAND_TAPS[8] = {
+    0.313737466f, -0.093090544f, 0.043988979f, -0.021591902f,
+    0.009804082f, -0.003772472f, 0.001064504f, -0.000125861f
+};
+
+// Filter output at the centre of a history (newest first), even taps are zero
+static inline float halfbandCentre(const float* history) {
+    const int centre = EqAnalysisEngine::HALFBAND_LENGTH / 2;
+    float sum = 0.5f * history[centre];
+    for (int k = 0; k < 8; k++) {
+        sum += HALFBAND_TAPS[k] * (history[centre - 1 - 2 * k] + history[centre + 1 + 2 * k]);
+    }
+    return sum;
+}
+
+EqAnalysisEngine::EqAnalysisEngine() : scheduler(AnalysisScheduler::instance()) {
+    configure(DEFAULT_FFT_SIZE, WINDOW_HANN);
+    scheduler.add(this);
 }
 
 EqAnalysisEngine::~EqAnalysisEngine() {
-    stopWorkerThread();
+    scheduler.remove(this);  // Waits for a job that is still running
+    delete fft;
+}
+
+void EqAnalysisEngine::setAnalysisSettings(int size, int windowType, int overlap) {
+    size = clamp(size, MIN_FFT_SIZE, MAX_FFT_SIZE);
+    overlap = clamp(overlap, 0, NUM_OVERLAPS - 1);
+    fftSizeSetting.store(size);
+    windowSetting.store(clamp(windowType, 0, NUM_WINDOWS - 1));
+    hopSize.store(size >> overlap);
+}
+
+void EqAnalysisEngine::configure(int size, int windowType) {
+    if (size != fftSize) {
+        delete fft;
+        fft = new dsp::RealFFT(size);
+        for (int i = 0; i < 2; i++) {
+            fftInput[i].assign(size, 0.0f);
+            fftOutput[i].assign(size, 0.0f);
+        }
+        for (int c = 0; c < NUM_CHANNELS; c++) {
+            workerBuffers[c].assign(size, 0.0f);
+            bins[c].assign(size / 2, 0.0f);
+        }
+        powerPrefix.assign(size / 2 + 1, 0.0);
+        windowTable.resize(size);
+        bandMapSampleRate = 0.0f;  // Bin spacing changed
+    }
+
+    // Periodic window, computed once per settings change
+    windowGain = 0.0f;
+    for (int i = 0; i < size; i++) {
+        double phase = 2.0 * M_PI * i / size;
+        double w;
+        if (windowType == WINDOW_BLACKMAN_HARRIS) {
+            w = 0.35875 - 0.48829 * std::cos(phase) + 0.14128 * std::cos(2.0 * phase) - 0.01168 * std::cos(3.0 * phase);
+        } else {
+            w = 0.5 - 0.5 * std::cos(phase);
+        }
+        windowTable[i] = (float)w;
+        windowGain += (float)w;
+    }
+    fftSize = size;
+    window = windowType;
+}
+
+bool EqAnalysisEngine::readLatestWindow(int numChannels) {
+    uint32_t end = writePos.load(std::memory_order_acquire);
+    uint32_t start = end - fftSize;
+    for (int c = 0; c < numChannels; c++) {
+        float* buffer = workerBuffers[c].data();
+        for (int i = 0; i < fftSize; i++) {
+            buffer[i] = ring[c][(start + i) & (RING_SIZE - 1)];
+        }
+    }
+    // The copy is only valid if the producer did not wrap into the window meanwhile
+    // (the fence keeps the ring reads above from moving past the re-load)
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint32_t advanced = writePos.load(std::memory_order_relaxed) - end;
+    return advanced <= (uint32_t)(RING_SIZE - fftSize);
+}
+
+void EqAnalysisEngine::run() {
+    int size = fftSizeSetting.load();
+    int windowType = windowSetting.load();
+    if (size != fftSize || windowType != window) {
+        configure(size, windowType);
+    }
+    bool multirateMode = multirateSetting.load();
+    if (multirateMode != multirate) {
+        multirate = multirateMode;
+        if (multirate) {
+            resetDecimation();
+        }
+        bandMapSampleRate = 0.0f;  // Band levels changed
+    }
+    float rate = sampleRate;
+    int smoothingType = smoothingSetting.load();
+    bool refreshAll = false;  // Every level must redraw its bands
+    if (rate != bandMapSampleRate || smoothingType != smoothing) {
+        smoothing = smoothingType;
+        buildBandMap(rate);
+        refreshAll = true;
+    }
+
+    // Output and (optionally) input from the same window, one stereo FFT each
+    int numChannels = preCapture.load() ? NUM_CHANNELS : PRE_LEFT;
+    if (numChannels != analysedChannels) {
+        analysedChannels = numChannels;
+        refreshAll = true;
+    }
+    if (multirate) {
+        decimateNewSamples(numChannels);
+    }
+    if (!readLatestWindow(numChannels)) return;
+    for (int c = 0; c < numChannels; c += 2) {
+        analysePair(c, 0);
+    }
+
+    // Decimated levels: one analysis per hop at their own rate
+    int numLevels = multirate ? NUM_RATE_LEVELS : 1;
+    uint32_t hop = (uint32_t)hopSize.load(std::memory_order_relaxed);
+    for (int level = 1; level < numLevels; level++) {
+        uint32_t produced = decimatedPos[level - 1];
+        if (!refreshAll && produced - levelAnalysedPos[level - 1] < hop) continue;
+        levelAnalysedPos[level - 1] = produced;
+        readDecimatedWindow(level, numChannels);
+        for (int c = 0; c < numChannels; c += 2) {
+            analysePair(c, level);
+        }
+    }
+    publishBands(numChannels);
 }
 
-void EqAnalysisEngine::startWorkerThread() {
-    if (!workerRunning) {
-        workerStop = false;
-        workerThread = std::thread(&EqAnalysisEngine::workerThreadFunc, this);
-        workerRunning = true;
+void EqAnalysisEngine::resetDecimation() {
+    for (int level = 0; level < NUM_RATE_LEVELS - 1; level++) {
+        for (int c = 0; c < NUM_CHANNELS; c++) {
+            decimatedRing[level][c].assign(DECIMATED_RING_SIZE, 0.0f);
+        }
+        decimatedPos[level] = 0;
+        levelAnalysedPos[level] = 0;
     }
+    for (int c = 0; c < NUM_CHANNELS; c++) {
+        for (int stage = 0; stage < DECIMATION_STAGES; stage++) {
+            for (int i = 0; i < 2 * HALFBAND_LENGTH; i++) {
+                decimationHistory[c][stage][i] = 0.0f;
+            }
+        }
+    }
+    for (int stage = 0; stage < DECIMATION_STAGES; stage++) {
+        decimationHistoryPos[stage] = 0;
+    }
+    decimationCount = 0;
+    decimationReadPos = writePos.load(std::memory_order_acquire) - RING_SIZE / 2;  // Start from recent history
 }
 
-void EqAnalysisEngine::stopWorkerThread() {
-    if (workerRunning) {
-        workerStop = true;
-        workerCV.notify_one();
-        if (workerThread.joinable()) {
-            workerThread.join();
+void EqAnalysisEngine::decimateNewSamples(int numChannels) {
+    // Everything written since the last job, at most half the ring (after a long stall
+    // the decimated levels skip the gap; the producer cannot reach these frames meanwhile)
+    uint32_t end = writePos.load(std::memory_order_acquire);
+    uint32_t count = std::min(end - decimationReadPos, (uint32_t)(RING_SIZE / 2));
+    uint32_t start = end - count;
+    for (uint32_t n = 0; n < count; n++) {
+        uint32_t index = (start + n) & (RING_SIZE - 1);
+        float values[NUM_CHANNELS];
+        for (int c = 0; c < numChannels; c++) {
+            values[c] = ring[c][index];
+        }
+        uint32_t phase = decimationCount++;
+        for (int stage = 0; stage < DECIMATION_STAGES; stage++) {
+            // Mirrored history: [pos, pos + HALFBAND_LENGTH) is contiguous, newest first
+            int& pos = decimationHistoryPos[stage];
+            pos = (pos == 0 ? HALFBAND_LENGTH : pos) - 1;
+            for (int c = 0; c < numChannels; c++) {
+                decimationHistory[c][stage][pos] = values[c];
+                decimationHistory[c][stage][pos + HALFBAND_LENGTH] = values[c];
+            }
+            // Stage s sees every 2^s-th input and outputs on every second of those
+            if (!((phase >> stage) & 1)) break;
+            for (int c = 0; c < numChannels; c++) {
+                values[c] = halfbandCentre(&decimationHistory[c][stage][pos]);
+            }
+            if (stage & 1) {
+                // Stages 1 and 3 complete the /4 and /16 levels
+                int ringIndex = stage / 2;
+                uint32_t slot = decimatedPos[ringIndex] & (DECIMATED_RING_SIZE - 1);
+                for (int c = 0; c < numChannels; c++) {
+                    decimatedRing[ringIndex][c][slot] = values[c];
+                }
+                decimatedPos[ringIndex]++;
+            }
         }
-        workerRunning = false;
     }
+    decimationReadPos = end;
 }
 
-void EqAnalysisEngine::addSample(float left, float right) {
-    leftBuffer[bufferIndex] = left;
-    rightBuffer[bufferIndex] = right;
-    bufferIndex = (bufferIndex + 1) % BUFFER_SIZE;
-    frameIndex++;
-    if (frameIndex >= frameCount) {
-        frameIndex = 0;
-        sendToWorker();
+void EqAnalysisEngine::readDecimatedWindow(int level, int numChannels) {
+    uint32_t start = decimatedPos[level - 1] - fftSize;
+    for (int c = 0; c < numChannels; c++) {
+        const float* source = decimatedRing[level - 1][c].data();
+        float* buffer = workerBuffers[c].data();
+        for (int i = 0; i < fftSize; i++) {
+            buffer[i] = source[(start + i) & (DECIMATED_RING_SIZE - 1)];
+        }
     }
 }
 
-void EqAnalysisEngine::sendToWorker() {
-    {
-        std::lock_guard<std::mutex> lock(bufferMutex);
-        for (int i = 0; i < BUFFER_SIZE; i++) {
-            leftWorkerBuffer[i] = leftBuffer[i];
-            rightWorkerBuffer[i] = rightBuffer[i];
-        }
-        newDataReady = true;
-    }
-    workerCV.notify_one();
-}
-
-void EqAnalysisEngine::workerThreadFunc() {
-    while (!workerStop) {
-        std::unique_lock<std::mutex> lock(bufferMutex);
-        workerCV.wait(lock, [this] { return newDataReady.load() || workerStop.load(); });
-        if (workerStop) break;
-        if (newDataReady) {
-            newDataReady = false;
-            float leftLocalBuffer[BUFFER_SIZE];
-            float rightLocalBuffer[BUFFER_SIZE];
-            for (int i = 0; i < BUFFER_SIZE; i++) {
-                leftLocalBuffer[i] = leftWorkerBuffer[i];
-                rightLocalBuffer[i] = rightWorkerBuffer[i];
+void EqAnalysisEngine::analysePair(int leftChannel, int level) {
+    // Window both channels in one pass, then both transforms and magnitudes
+    const float* left = workerBuffers[leftChannel].data();
+    const float* right = workerBuffers[leftChannel + 1].data();
+    float* leftInput = fftInput[0].data();
+    float* rightInput = fftInput[1].data();
+    for (int i = 0; i < fftSize; i++) {
+        leftInput[i] = left[i] * windowTable[i];
+        rightInput[i] = right[i] * windowTable[i];
+    }
+    for (int i = 0; i < 2; i++) {
+        fft->rfft(fftInput[i].data(), fftOutput[i].data());
+    }
+    for (int i = 0; i < 2; i++) {
+        computeMagnitudes(fftOutput[i].data(), bins[leftChannel + i].data());
+    }
+    for (int c = leftChannel; c <= leftChannel + 1; c++) {
+        if (smoothing != SMOOTHING_OFF) {
+            smoothToLogScale(bins[c].data(), bands[c], level);
+        } else {
+            mapToLogScale(bins[c].data(), bands[c], level);
+        }
+    }
+}
+
+void EqAnalysisEngine::buildBandMap(float rate) {
+    int numLevels = multirate ? NUM_RATE_LEVELS : 1;
+    for (int level = 0; level < numLevels; level++) {
+        float levelRate = rate / (float)(1 << (2 * level));
+        int* start = bandBinStart[level];
+        int* end = bandBinEnd[level];
+        for (int i = 0; i < DISPLAY_BANDS; i++) {
+            start[i] = 0;
+            end[i] = 0;
+        }
+        for (int bin = 1; bin < fftSize / 2; bin++) {
+            float frequency = (float)bin * levelRate / (float)fftSize;
+            if (frequency < MIN_FREQ || frequency > MAX_FREQ) continue;
+            float logFreq = log10f(frequency);
+            float bandPos = (logFreq - MIN_LOG_FREQ) / (MAX_LOG_FREQ - MIN_LOG_FREQ) * (float)(DISPLAY_BANDS - 1);
+            int band = (int)roundf(bandPos);
+            band = clamp(band, 0, DISPLAY_BANDS - 1);
+            if (end[band] == 0) {
+                start[band] = bin;
             }
-            lock.unlock();
-            processFFTWorker(leftLocalBuffer, rightLocalBuffer);
+            end[band] = bin + 1;
+        }
+        buildSmoothingMap(level, levelRate);
+    }
+
+    // Each band from the slowest level whose usable band still covers the band's upper edge
+    float bandStep = (MAX_LOG_FREQ - MIN_LOG_FREQ) / (float)(DISPLAY_BANDS - 1);
+    for (int i = 0; i < DISPLAY_BANDS; i++) {
+        float upperEdge = std::pow(10.0f, MIN_LOG_FREQ + ((float)i + 0.5f) * bandStep);
+        int level = numLevels - 1;
+        while (level > 0 && upperEdge > LEVEL_MAX_FREQ * rate / (float)(1 << (2 * level))) {
+            level--;
         }
+        bandLevel[i] = level;
     }
+    bandMapSampleRate = rate;
 }
 
-void EqAnalysisEngine::processFFTWorker(float* leftInputBuffer, float* rightInputBuffer) {
-    for (int i = 0; i < BUFFER_SIZE; i++) {
-        fftInput[i] = leftInputBuffer[i];
+void EqAnalysisEngine::buildSmoothingMap(int level, float rate) {
+    if (smoothing == SMOOTHING_OFF) return;
+    const int fractions[NUM_SMOOTHINGS] = {0, 3, 6, 12};
+    float halfWidth = std::pow(2.0f, 0.5f / fractions[smoothing]);  // Band edges at fc * 2^(+-1/2N)
+    float binWidth = rate / (float)fftSize;
+    int maxBin = fftSize / 2 - 1;
+    for (int i = 0; i < DISPLAY_BANDS; i++) {
+        float logFreq = MIN_LOG_FREQ + (MAX_LOG_FREQ - MIN_LOG_FREQ) * i / (float)(DISPLAY_BANDS - 1);
+        float center = std::pow(10.0f, logFreq);
+        int start = (int)std::ceil(center / halfWidth / binWidth);
+        int end = (int)std::floor(center * halfWidth / binWidth) + 1;
+        if (end <= start) {
+            // Window narrower than one bin (low end): use the nearest bin
+            start = (int)std::round(center / binWidth);
+            end = start + 1;
+        }
+        smoothBinStart[level][i] = clamp(start, 1, maxBin);
+        smoothBinEnd[level][i] = clamp(end, smoothBinStart[level][i] + 1, maxBin + 1);
     }
-    fft.rfft(fftInput, fftOutput);
-    for (int i = 0; i < BUFFER_SIZE / 2; i++) {
-        float real = fftOutput[2 * i];
-        float imag = fftOutput[2 * i + 1];
-        spectrum[i] = sqrtf(real * real + imag * imag) / BUFFER_SIZE;
+}
+
+void EqAnalysisEngine::computeMagnitudes(const float* spectrum, float* binsOut) {
+    // Four bins per step: de-interleave the re/im pairs of the ordered RealFFT output
+    const float scale = 1.0f / windowGain;
+    for (int k = 0; k < fftSize / 2; k += 4) {
+        float_4 a = float_4::load(&spectrum[2 * k]);
+        float_4 b = float_4::load(&spectrum[2 * k + 4]);
+        float_4 re(a[0], a[2], b[0], b[2]);
+        float_4 im(a[1], a[3], b[1], b[3]);
+        (simd::sqrt(re * re + im * im) * scale).store(&binsOut[k]);
+    }
+    binsOut[0] = std::fabs(spectrum[0]) * scale;  // Slot 1 holds Nyquist, not DC's imaginary part
+}
+
+void EqAnalysisEngine::mapToLogScale(const float* spectrum, float* bandOut, int level) {
+    for (int i = 0; i < DISPLAY_BANDS; i++) {
+        if (bandLevel[i] != level) continue;
+        // Band maximum over its bin range, four bins at a time
+        int bin = bandBinStart[level][i];
+        int end = bandBinEnd[level][i];
+        float bandMax = 0.0f;
+        if (end - bin >= 4) {
+            float_4 max4 = float_4::load(&spectrum[bin]);
+            for (bin += 4; bin + 4 <= end; bin += 4) {
+                max4 = simd::fmax(max4, float_4::load(&spectrum[bin]));
+            }
+            bandMax = std::max(std::max(max4[0], max4[1]), std::max(max4[2], max4[3]));
+        }
+        for (; bin < end; bin++) {
+            bandMax = std::max(bandMax, spectrum[bin]);
+        }
+        bandOut[i] = bandMax;
     }
-    mapToLogScale(true);
-    for (int i = 0; i < BUFFER_SIZE; i++) {
-        fftInput[i] = rightInputBuffer[i];
+}
+
+void EqAnalysisEngine::smoothToLogScale(const float* spectrum, float* bandOut, int level) {
+    // Prefix sum of bin powers, then the RMS over each band's window
+    double* prefix = powerPrefix.data();
+    prefix[0] = 0.0;
+    for (int bin = 0; bin < fftSize / 2; bin++) {
+        prefix[bin + 1] = prefix[bin] + (double)spectrum[bin] * spectrum[bin];
     }
-    fft.rfft(fftInput, fftOutput);
-    for (int i = 0; i < BUFFER_SIZE / 2; i++) {
-        float real = fftOutput[2 * i];
-        float imag = fftOutput[2 * i + 1];
-        spectrum[i] = sqrtf(real * real + imag * imag) / BUFFER_SIZE;
+    for (int i = 0; i < DISPLAY_BANDS; i++) {
+        if (bandLevel[i] != level) continue;
+        int start = smoothBinStart[level][i];
+        int end = smoothBinEnd[level][i];
+        double meanPower = (prefix[end] - prefix[start]) / (end - start);
+        bandOut[i] = (float)std::sqrt(std::max(meanPower, 0.0));
     }
-    mapToLogScale(false);
 }
 
-void EqAnalysisEngine::mapToLogScale(bool isLeftChannel) {
+void EqAnalysisEngine::publishBands(int numChannels) {
     std::lock_guard<std::mutex> lock(spectrumMutex);
-    float* targetSpectrum = isLeftChannel ? leftLogSpectrum : rightLogSpectrum;
+    for (int c = 0; c < numChannels; c++) {
+        for (int i = 0; i < DISPLAY_BANDS; i++) {
+            raw[c][i] = bands[c][i];
+        }
+    }
+}
+
+void EqAnalysisEngine::updateDisplay(double time) {
+    float dt = (lastDisplayTime < 0.0) ? 0.0f : (float)std::min(time - lastDisplayTime, 1.0);
+    lastDisplayTime = time;
+
+    float latest[NUM_CHANNELS][DISPLAY_BANDS];
+    {
+        std::lock_guard<std::mutex> lock(spectrumMutex);
+        for (int c = 0; c < NUM_CHANNELS; c++) {
+            for (int i = 0; i < DISPLAY_BANDS; i++) {
+                latest[c][i] = raw[c][i];
+            }
+        }
+    }
+    for (int c = 0; c < NUM_CHANNELS; c++) {
+        applyBallistics(latest[c], display[c], peakHold[c], peakAge[c], dt, averagingTime);
+    }
+
+    // Difference of the (averaged) output and input, stereo power summed
+    const float floor = 1e-5f;  // About -100 dB, below that the ratio is noise
     for (int i = 0; i < DISPLAY_BANDS; i++) {
-        targetSpectrum[i] = 0.0f;
-    }
-    for (int bin = 1; bin < BUFFER_SIZE / 2; bin++) {
-        float frequency = (float)bin * sampleRate / (float)BUFFER_SIZE;
-        if (frequency < MIN_FREQ || frequency > MAX_FREQ) continue;
-        float logFreq = log10f(frequency);
-        float bandPos = (logFreq - MIN_LOG_FREQ) / (MAX_LOG_FREQ - MIN_LOG_FREQ) * (float)(DISPLAY_BANDS - 1);
-        int band = (int)roundf(bandPos);
-        band = clamp(band, 0, DISPLAY_BANDS - 1);
-        targetSpectrum[band] = std::max(targetSpectrum[band], spectrum[bin]);
-    }
-    float* peakHold = isLeftChannel ? leftPeakHold : rightPeakHold;
-    float* peakTimer = isLeftChannel ? leftPeakTimer : rightPeakTimer;
+        float post = display[LEFT][i] * display[LEFT][i] + display[RIGHT][i] * display[RIGHT][i];
+        float pre = display[PRE_LEFT][i] * display[PRE_LEFT][i] + display[PRE_RIGHT][i] * display[PRE_RIGHT][i];
+        differenceDb[i] = (pre > floor * floor) ? 10.0f * std::log10(std::max(post, floor * floor) / pre) : 0.0f;
+    }
+}
+
+void EqAnalysisEngine::applyBallistics(const float* raw, float* display, float* peakHold, float* peakAge,
+                                       float dt, float averaging) {
+    // Exponential averaging with a time constant in seconds (off = raw magnitudes)
+    float averageCoeff = (averaging > 0.0f) ? 1.0f - std::exp(-dt / averaging) : 1.0f;
+    float peakDecay = std::pow(PEAK_DECAY_RATE, dt * 60.0f);
     for (int i = 0; i < DISPLAY_BANDS; i++) {
-        targetSpectrum[i] *= 0.9999f;
-        if (targetSpectrum[i] > peakHold[i]) {
-            peakHold[i] = targetSpectrum[i];
-            peakTimer[i] = 0.5f;
+        display[i] += (raw[i] - display[i]) * averageCoeff;
+        if (display[i] > peakHold[i]) {
+            peakHold[i] = display[i];
+            peakAge[i] = 0.0f;
         } else {
-            peakTimer[i] -= 1.0f / 60.0f;
-            if (peakTimer[i] <= 0.0f) {
-                peakHold[i] = std::max(targetSpectrum[i], peakHold[i] * 0.98f);
+            peakAge[i] += dt;
+            if (peakAge[i] >= PEAK_HOLD_TIME) {
+                peakHold[i] = std::max(display[i], peakHold[i] * peakDecay);
             }
         }
     }
@@ -125,25 +401,24 @@ void EqAnalysisEngine::mapToLogScale(bool isLeftChannel) {
 
 void EqAnalysisEngine::getSpectrumData(float* leftSpectrum, float* rightSpectrum,
                                      float* leftPeaks, float* rightPeaks) {
-    std::lock_guard<std::mutex> lock(spectrumMutex);
     if (leftSpectrum) {
         for (int i = 0; i < DISPLAY_BANDS; i++) {
-            leftSpectrum[i] = leftLogSpectrum[i];
+            leftSpectrum[i] = display[LEFT][i];
         }
     }
     if (rightSpectrum) {
         for (int i = 0; i < DISPLAY_BANDS; i++) {
-            rightSpectrum[i] = rightLogSpectrum[i];
+            rightSpectrum[i] = display[RIGHT][i];
         }
     }
     if (leftPeaks) {
         for (int i = 0; i < DISPLAY_BANDS; i++) {
-            leftPeaks[i] = leftPeakHold[i];
+            leftPeaks[i] = peakHold[LEFT][i];
         }
     }
     if (rightPeaks) {
         for (int i = 0; i < DISPLAY_BANDS; i++) {
-            rightPeaks[i] = rightPeakHold[i];
+            rightPeaks[i] = peakHold[RIGHT][i];
         }
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,246 @@
+#include "LinearPhaseEngine.hpp"
+#include <complex>
+#include <cstring>
+
+LinearPhaseEngine::LinearPhaseEngine() {
+    for (int i = 0; i < NUM_PARTITION_SIZES; ++i) {
+        blockFFT[i] = new dsp::RealFFT(2 * partitionSizeForIndex(i));
+        partitionFFT[i] = new dsp::RealFFT(2 * partitionSizeForIndex(i));
+    }
+    designFFT = new dsp::RealFFT(2 * FIR_LENGTH);
+    workerThread = std::thread(&LinearPhaseEngine::workerThreadFunc, this);
+}
+
+LinearPhaseEngine::~LinearPhaseEngine() {
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        workerStop = true;
+    }
+    jobCV.notify_one();
+    if (workerThread.joinable()) {
+        workerThread.join();
+    }
+    for (int i = 0; i < NUM_PARTITION_SIZES; ++i) {
+        delete blockFFT[i];
+        delete partitionFFT[i];
+    }
+    delete designFFT;
+}
+
+int LinearPhaseEngine::partitionIndex(int size) {
+    int index = 0;
+    while (index < NUM_PARTITION_SIZES - 1 && partitionSizeForIndex(index) < size) {
+        index++;
+    }
+    return index;
+}
+
+void LinearPhaseEngine::setPartitionSize(int size) {
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        partitionSizeSetting = partitionSizeForIndex(partitionIndex(size));
+        if (haveSections) {
+            jobPending = true;
+        }
+    }
+    jobCV.notify_one();
+}
+
+bool LinearPhaseEngine::requestDesign(const Section* sections) {
+    // Never block the audio thread: a busy worker just means trying again next update
+    std::unique_lock<std::mutex> lock(jobMutex, std::try_to_lock);
+    if (!lock.owns_lock()) return false;
+    for (int s = 0; s < NUM_SECTIONS; ++s) {
+        jobSections[s] = sections[s];
+    }
+    haveSections = true;
+    jobPending = true;
+    lock.unlock();
+    jobCV.notify_one();
+    return true;
+}
+
+void LinearPhaseEngine::reset() {
+    for (int g = 0; g < MAX_GROUPS; ++g) {
+        resetGroup(g);
+    }
+    blockPos = 0;
+    fdlPos = 0;
+}
+
+void LinearPhaseEngine::resetGroup(int group) {
+    for (int i = 0; i < MAX_PARTITION_SIZE; ++i) {
+        inputBlock[group][i] = float_4::zero();
+        outputBlock[group][i] = float_4::zero();
+    }
+    for (int lane = 4 * group; lane < 4 * group + 4; ++lane) {
+        std::memset(history[lane], 0, sizeof(history[lane]));
+        std::memset(fdl[lane], 0, sizeof(fdl[lane]));
+    }
+}
+
+void LinearPhaseEngine::processBlock(int groups) {
+    // Pick up a newly designed filter at the block boundary
+    int fadeFrom = -1;
+    int ready = published.exchange(-1);
+    if (ready >= 0) {
+        if (filters[ready].partitionSize != partitionSize) {
+            // New block length: restart the convolution (the latency changes anyway)
+            partitionSize = filters[ready].partitionSize;
+            numPartitions = filters[ready].numPartitions;
+            active = ready;
+            reset();
+            return;
+        }
+        fadeFrom = active;
+        active = ready;
+    }
+    if (active < 0) return;  // Nothing designed yet, output stays silent
+
+    const int size = partitionSize;
+    const int n = 2 * size;
+    dsp::RealFFT* fft = blockFFT[partitionIndex(size)];
+    const float fadeStep = 1.0f / size;
+
+    for (int lane = 0; lane < 4 * groups; ++lane) {
+        int g = lane / 4;
+        int j = lane % 4;
+
+        // Overlap-save frame: previous block followed by the current one
+        for (int i = 0; i < size; ++i) {
+            float x = inputBlock[g][i][j];
+            frame[i] = history[lane][i];
+            frame[size + i] = x;
+            history[lane][i] = x;
+        }
+        fft->rfft(frame, &fdl[lane][fdlPos * n]);
+
+        // Only the second half of the frame is free of circular wrap-around
+        convolve(filters[active], lane, convolved);
+        if (fadeFrom >= 0) {
+            convolve(filters[fadeFrom], lane, faded);
+            for (int i = 0; i < size; ++i) {
+                float t = (i + 1) * fadeStep;
+                outputBlock[g][i][j] = faded[size + i] + (convolved[size + i] - faded[size + i]) * t;
+            }
+        } else {
+            for (int i = 0; i < size; ++i) {
+                outputBlock[g][i][j] = convolved[size + i];
+            }
+        }
+    }
+
+    if (++fdlPos >= numPartitions) {
+        fdlPos = 0;
+    }
+}
+
+void LinearPhaseEngine::convolve(const Filter& filter, int lane, float* output) {
+    const int n = 2 * partitionSize;
+    std::memset(accumulator, 0, n * sizeof(float));
+
+    // Multiply-accumulate the delay line against the filter partitions
+    // (ordered real FFT layout: DC and Nyquist in [0] and [1], then re/im pairs)
+    for (int p = 0; p < numPartitions; ++p) {
+        int slot = fdlPos - p;
+        if (slot < 0) slot += numPartitions;
+        const float* x = &fdl[lane][slot * n];
+        const float* h = &filter.spectra[p * n];
+
+        accumulator[0] += x[0] * h[0];
+        accumulator[1] += x[1] * h[1];
+        for (int i = 2; i < n; i += 2) {
+            accumulator[i] += x[i] * h[i] - x[i + 1] * h[i + 1];
+            accumulator[i + 1] += x[i] * h[i + 1] + x[i + 1] * h[i];
+        }
+    }
+
+    blockFFT[partitionIndex(partitionSize)]->irfft(accumulator, output);
+}
+
+void LinearPhaseEngine::workerThreadFunc() {
+    while (true) {
+        Section sections[NUM_SECTIONS];
+        int size;
+        {
+            std::unique_lock<std::mutex> lock(jobMutex);
+            jobCV.wait(lock, [this] { return jobPending || workerStop.load(); });
+            if (workerStop) break;
+            jobPending = false;
+            for (int s = 0; s < NUM_SECTIONS; ++s) {
+                sections[s] = jobSections[s];
+            }
+            size = partitionSizeSetting.load();
+        }
+
+        // Take back a filter the audio thread has not picked up yet and overwrite it,
+        // otherwise fill the one that is neither playing nor fading out
+        int target = published.exchange(-1);
+        if (target < 0) {
+            target = 0;
+            while (target == recentFilters[0] || target == recentFilters[1]) {
+                target++;
+            }
+            recentFilters[1] = recentFilters[0];
+            recentFilters[0] = target;
+        }
+
+        design(sections, size, filters[target]);
+        published.store(target);
+    }
+}
+
+void LinearPhaseEngine::design(const Section* sections, int size, Filter& filter) {
+    const int gridSize = 2 * FIR_LENGTH;
+
+    // Zero-phase magnitude response of the cascade (bilinear-mapped analog prototypes)
+    for (int i = 0; i <= gridSize / 2; ++i) {
+        double magnitude = 1.0;
+        for (int s = 0; s < NUM_SECTIONS; ++s) {
+            const Section& c = sections[s];
+            if (c.g <= 0.0f) continue;
+            if (i == gridSize / 2) {
+                magnitude *= std::abs((double)c.m0);  // s -> infinity at Nyquist
+                continue;
+            }
+            std::complex<double> sj(0.0, std::tan(M_PI * i / gridSize) / c.g);
+            std::complex<double> h = (double)c.m0 + ((double)c.m1 * sj + (double)c.m2) / (sj * sj + (double)c.k * sj + 1.0);
+            magnitude *= std::abs(h);
+        }
+        if (i == 0) {
+            designSpectrum[0] = magnitude;
+        } else if (i == gridSize / 2) {
+            designSpectrum[1] = magnitude;
+        } else {
+            designSpectrum[2 * i] = magnitude;
+            designSpectrum[2 * i + 1] = 0.0f;
+        }
+    }
+    designFFT->irfft(designSpectrum, designImpulse);
+
+    // Centre the (circularly even) impulse response and apply a Blackman window
+    const int span = 2 * LATENCY_TAPS;
+    for (int j = 0; j <= span; ++j) {
+        int index = (j - LATENCY_TAPS + gridSize) % gridSize;
+        double phase = 2.0 * M_PI * j / span;
+        double window = 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+        taps[j] = designImpulse[index] / gridSize * window;
+    }
+    for (int j = span + 1; j < FIR_LENGTH; ++j) {
+        taps[j] = 0.0f;
+    }
+
+    // Partition spectra, scaled so the inverse FFT needs no further normalisation
+    const int n = 2 * size;
+    dsp::RealFFT* fft = partitionFFT[partitionIndex(size)];
+    const float scale = 1.0f / n;
+    filter.partitionSize = size;
+    filter.numPartitions = FIR_LENGTH / size;
+    for (int p = 0; p < filter.numPartitions; ++p) {
+        for (int i = 0; i < size; ++i) {
+            designFrame[i] = taps[p * size + i] * scale;
+            designFrame[size + i] = 0.0f;
+        }
+        fft->rfft(designFrame, &filter.spectra[p * n]);
+    }
+}
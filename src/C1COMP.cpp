@@ -5,6 +5,7 @@
 #include "../shared/include/FETCompressor.hpp"
 #include "../shared/include/OpticalCompressor.hpp"
 #include "../shared/include/VariMuCompressor.hpp"
+#include "../shared/include/AuditionCompressor.hpp"
 
 // Custom ParamQuantity for Bypass button with ON/OFF labels
 struct BypassParamQuantity : ParamQuantity {
@@ -687,6 +688,10 @@ struct C1COMP : Module {
     // DSP core - pointer to current compressor engine
     CompressorEngine* comp = nullptr;
 
+    // Audition mode: all four engines run side by side, compressorType picks the audible lane
+    AuditionCompressor auditioner;
+    bool auditionMode = false;
+
     dsp::ClockDivider lightDivider;  // LED update clock divider (update every 256 samples)
 
     // Compressor type selection
@@ -804,6 +809,7 @@ struct C1COMP : Module {
         use10VReference = false; // 5V reference
         vuMeterBarMode = false;  // Dot mode (off)
         kneeOverride = -1.0f;    // Auto
+        auditionMode = false;    // Off
 
         // Ensure engine is updated to default type
         if (lastCompressorType != compressorType) {
@@ -844,6 +850,14 @@ struct C1COMP : Module {
                 compressorType = VCA_TYPE;
                 break;
         }
+
+        // Audition lanes keep their detector state - only the audible lane changes
+        auditioner.setActiveLane(compressorType);
+    }
+
+    // Engine currently driving the audio path
+    CompressorEngine* activeEngine() {
+        return auditionMode ? &auditioner : comp;
     }
 
     void process(const ProcessArgs& args) override {
@@ -855,8 +869,10 @@ struct C1COMP : Module {
             lastCompressorType = compressorType;
         }
 
+        CompressorEngine* engine = activeEngine();
+
         // Set sample rate (recalculates attack/release coefficients if changed)
-        comp->setSampleRate(args.sampleRate);
+        engine->setSampleRate(args.sampleRate);
 
         // Calculate peak decay coefficient (300ms time constant)
         if (peakDecayCoeff == 0.0f) {
@@ -906,7 +922,7 @@ struct C1COMP : Module {
         }
 
         // Update compressor parameters
-        updateCompressorParameters();
+        updateCompressorParameters(engine);
 
         // DSP processing
         float dryL = inL, dryR = inR;
@@ -916,9 +932,9 @@ struct C1COMP : Module {
         if (inputs[SIDECHAIN_INPUT].getChannels() > 0) {
             float scSignal = inputs[SIDECHAIN_INPUT].getVoltage();
             float scLevel = std::abs(scSignal);  // Rectify for detection
-            comp->processStereoWithKey(inL, inR, scLevel, &wetL, &wetR);
+            engine->processStereoWithKey(inL, inR, scLevel, &wetL, &wetR);
         } else {
-            comp->processStereo(inL, inR, &wetL, &wetR);
+            engine->processStereo(inL, inR, &wetL, &wetR);
         }
 
         // Parallel compression (dry/wet mix) - with CV modulation from COM-X
@@ -937,7 +953,7 @@ struct C1COMP : Module {
         outputs[RIGHT_OUTPUT].setVoltage(outR * outputGainLin * inputScaling);
 
         // Update GR meter (0dB to -20dB, inverted display) - feed zero if display disabled
-        float gr = comp->getGainReduction();  // Returns dB (negative values = gain reduction)
+        float gr = engine->getGainReduction();  // Returns dB (negative values = gain reduction)
         float grNorm = displayEnabled ? clamp(-gr / 20.0f, 0.0f, 1.0f) : 0.0f;  // Normalize: 0dB=0.0, -20dB=1.0
         // GR meter: instant attack, exponential decay
         if (grNorm > peakGR) {
@@ -952,7 +968,7 @@ struct C1COMP : Module {
 
         // Update VU meter (gain reduction display) at reduced rate
         if (updateLights) {
-            updateVUMeter();
+            updateVUMeter(engine);
         }
     }
 
@@ -975,7 +991,7 @@ struct C1COMP : Module {
         }
     }
 
-    void updateCompressorParameters() {
+    void updateCompressorParameters(CompressorEngine* engine) {
         // Read CV modulation from COM-X expander (if connected)
         float ratioCVMod = 0.0f;
         float thresholdCVMod = 0.0f;
@@ -993,50 +1009,50 @@ struct C1COMP : Module {
         int attackIndex = (int)std::round(params[ATTACK_PARAM].getValue());  // 0-5 (already snapped)
         attackIndex = clamp(attackIndex, 0, 5);
         float attack = attackValues[attackIndex];
-        comp->setAttack(attack);
+        engine->setAttack(attack);
 
         // Release: Continuous 100ms-1200ms (0-90%) or AUTO (90-100%)
         // CV modulation limited to 0-89% range to preserve AUTO mode access
         float releaseRaw = clamp(params[RELEASE_PARAM].getValue() + releaseCVMod, 0.0f, 0.89f);  // 0.0 to 0.89
         if (releaseRaw >= 0.9f) {
             // AUTO zone (90-100%)
-            comp->setAutoRelease(true);
+            engine->setAutoRelease(true);
         } else {
             // Continuous zone (0-90%) - logarithmic scaling for musical control
-            comp->setAutoRelease(false);
+            engine->setAutoRelease(false);
             float normalizedRelease = releaseRaw / 0.9f;  // Rescale 0-0.9 to 0-1
             // Logarithmic mapping: 100ms to 1200ms
             // log(1200/100) = log(12) ≈ 2.485
             float release = 100.0f * std::pow(12.0f, normalizedRelease);
-            comp->setRelease(release);
+            engine->setRelease(release);
         }
 
         // Threshold: -20dB to +10dB (SSL G-series range)
         float thresholdBase = rescale(params[THRESHOLD_PARAM].getValue(), 0.0f, 1.0f, -20.0f, 10.0f);
         float threshold = clamp(thresholdBase + thresholdCVMod, -20.0f, 10.0f);
-        comp->setThreshold(threshold);
+        engine->setThreshold(threshold);
 
         // Ratio: 1:1 to 20:1 (logarithmic taper for musical control)
         // Musical ratios: 2:1 (25%), 4:1 (50%), 8:1 (75%), 20:1 (100%)
         float ratioParam = clamp(params[RATIO_PARAM].getValue() + ratioCVMod, 0.0f, 1.0f);  // 0.0 to 1.0
         float ratio = 1.0f + std::pow(ratioParam, 2.0f) * 19.0f;
-        comp->setRatio(ratio);
+        engine->setRatio(ratio);
 
         // Makeup gain
         if (autoMakeup) {
             // Simple auto-makeup: compensate for threshold
             float autoGainDb = -threshold * 0.5f;
-            comp->setMakeup(autoGainDb);
+            engine->setMakeup(autoGainDb);
         } else {
-            comp->setMakeup(0.0f);
+            engine->setMakeup(0.0f);
         }
 
         // Knee override
-        comp->setKnee(kneeOverride);  // -1 = use engine defaults, 0-12 = override
+        engine->setKnee(kneeOverride);  // -1 = use engine defaults, 0-12 = override
     }
 
-    void updateVUMeter() {
-        float gr = comp->getGainReduction();  // Returns dB (negative values = gain reduction)
+    void updateVUMeter(CompressorEngine* engine) {
+        float gr = engine->getGainReduction();  // Returns dB (negative values = gain reduction)
 
         // Simple linear mapping: 0dB to -20dB across 11 LEDs
         // LED 10 (right) = 0dB (no compression), LED 0 (left) = -20dB (heavy compression)
@@ -1068,6 +1084,7 @@ struct C1COMP : Module {
         json_object_set_new(rootJ, "inputGainDb", json_real(inputGainDb));
         json_object_set_new(rootJ, "outputGainDb", json_real(outputGainDb));
         json_object_set_new(rootJ, "kneeOverride", json_real(kneeOverride));
+        json_object_set_new(rootJ, "auditionMode", json_boolean(auditionMode));
         return rootJ;
     }
 
@@ -1102,6 +1119,10 @@ struct C1COMP : Module {
         json_t* kneeOverrideJ = json_object_get(rootJ, "kneeOverride");
         if (kneeOverrideJ)
             kneeOverride = json_real_value(kneeOverrideJ);
+
+        json_t* auditionModeJ = json_object_get(rootJ, "auditionMode");
+        if (auditionModeJ)
+            auditionMode = json_boolean_value(auditionModeJ);
     }
 };
 
@@ -1453,6 +1474,7 @@ struct C1COMPWidget : ModuleWidget {
                 if (!module) return;
 
                 const char* typeNames[4] = {"VCA", "FET", "OPTICAL", "VARI-MU"};
+                const char* auditionNames[4] = {"VCA A/B", "FET A/B", "OPTICAL A/B", "VARI-MU A/B"};
                 int type = module->compressorType;
                 type = clamp(type, 0, 3);
 
@@ -1460,7 +1482,7 @@ struct C1COMPWidget : ModuleWidget {
                 nvgFontFaceId(args.vg, APP->window->uiFont->handle);
                 nvgTextAlign(args.vg, NVG_ALIGN_LEFT | NVG_ALIGN_MIDDLE);
                 nvgFillColor(args.vg, nvgRGBA(0xFF, 0xC0, 0x50, 200));  // Amber
-                nvgText(args.vg, 0, box.size.y / 2, typeNames[type], NULL);
+                nvgText(args.vg, 0, box.size.y / 2, module->auditionMode ? auditionNames[type] : typeNames[type], NULL);
             }
         };
 
@@ -1728,6 +1750,9 @@ struct C1COMPWidget : ModuleWidget {
             "Vari-Mu (Fairchild)"
         }, &module->compressorType));
 
+        // Audition Mode: run all four engines, switch types instantly without detector reset
+        menu->addChild(createBoolPtrMenuItem("Audition Mode (A/B all types)", "", &module->auditionMode));
+
         menu->addChild(new MenuSeparator);
 
         // Input Reference Level
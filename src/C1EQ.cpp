@@ -11,8 +11,11 @@
 #include "plugin.hpp"
 #include "../shared/include/TCLogo.hpp"
 #include "EqAnalysisEngine.hpp"
+#include "LinearPhaseEngine.hpp"
 #include <array>
+#include <atomic>
 #include <cmath>
+#include <complex>
 
 using namespace rack;
 using namespace simd;
@@ -190,24 +193,26 @@ struct LedRingOverlaySkip4 : widget::TransparentWidget {
 };
 
 // Memory-safe parameter smoother (stack-based)
+// Coefficient is computed once in init(), so process() is a single multiply-add
 struct SafeParamSmoother {
-    double smoothed = 0.0;
-    double tau_ms = 10.0;
-    double sampleRate = 44100.0;
+    float smoothed = 0.0f;
+    float tau_ms = 10.0f;
+    float sampleRate = 44100.0f;
+    float alpha = 1.0f;
 
     void init(double sr, double initial = 0.0, double tau = 10.0) {
         sampleRate = sr > 0.0 ? sr : 44100.0;  // Safe fallback
         smoothed = initial;
         tau_ms = tau;
+        alpha = 1.0f - std::exp(-1000.0f / (tau_ms * sampleRate));
     }
 
-    inline double process(double target) {
-        double alpha = 1.0 - std::exp(-1000.0 / (tau_ms * sampleRate));
+    inline float process(float target) {
         smoothed += alpha * (target - smoothed);
         return smoothed;
     }
 
-    inline void setImmediate(double v) { smoothed = v; }
+    inline void setImmediate(float v) { smoothed = v; }
 };
 
 // Memory-safe biquad filter
@@ -228,7 +233,105 @@ struct SafeBiquad {
     }
 };
 
+// Fast float tanh: odd 13/6 rational approximation (Eigen-style)
+// Max absolute error ~3.3e-7 over the whole real line (input clamped where tanh = 1 in float)
+inline float_4 fastTanh(float_4 x) {
+    x = simd::clamp(x, -7.90531110763549805f, 7.90531110763549805f);
+    float_4 x2 = x * x;
+
+    float_4 p = -2.76076847742355e-16f;
+    p = p * x2 + 2.00018790482477e-13f;
+    p = p * x2 + -8.60467152213735e-11f;
+    p = p * x2 + 5.12229709037114e-08f;
+    p = p * x2 + 1.48572235717979e-05f;
+    p = p * x2 + 6.37261928875436e-04f;
+    p = p * x2 + 4.89352455891786e-03f;
+    p = p * x;
+
+    float_4 q = 1.19825839466702e-06f;
+    q = q * x2 + 1.18534705686654e-04f;
+    q = q * x2 + 2.26843463243900e-03f;
+    q = q * x2 + 4.89352518554385e-03f;
+
+    return p / q;
+}
+
+// First-order antiderivative anti-aliasing (ADAA) for tanh(drive * x) / drive
+// y = (F(x[n]) - F(x[n-1])) / (x[n] - x[n-1]) with F(x) = log(cosh(drive * x)) / drive^2
+// log(cosh(u)) = |u| + log(1 + exp(-2|u|)) - log(2); the |u| part is differenced
+// analytically so float precision holds up at large inputs
+// Adds half a sample of delay; falls back to the midpoint for tiny input steps
+struct ADAATanh {
+    float drive = 1.0f;
+    float_4 x1 = 0.0f;  // Previous input
+    float_4 L1 = 0.0f;  // log(1 + exp(-2|u|)) at previous input
+
+    void init(float d) {
+        drive = d;
+        reset();
+    }
+
+    void reset() {
+        x1 = 0.0f;
+        L1 = M_LN2;
+    }
+
+    // Midpoint of the current and previous input (linear terms must use it to stay aligned)
+    inline float_4 mid(float_4 x) const { return 0.5f * (x + x1); }
+
+    inline float_4 process(float_4 x) {
+        float_4 u = drive * x;
+        float_4 u1 = drive * x1;
+        float_4 L = simd::log(1.0f + simd::exp(-2.0f * simd::fabs(u)));
+        float_4 dx = x - x1;
+        float_4 safeDx = simd::ifelse(simd::fabs(dx) > 1e-3f, dx, 1.0f);
+
+        // (|u| - |u1|) / dx: exact sign(u) * drive when both share a sign
+        float_4 sameSign = (u * u1) >= 0.0f;
+        float_4 absTerm = simd::ifelse(sameSign, simd::sgn(u + u1) * drive, (simd::fabs(u) - simd::fabs(u1)) / safeDx);
+        float_4 adaa = (absTerm + (L - L1) / safeDx) / (drive * drive);
+        float_4 fallback = fastTanh(drive * mid(x)) / drive;
+
+        float_4 y = simd::ifelse(simd::fabs(dx) > 1e-3f, adaa, fallback);
+        x1 = x;
+        L1 = L;
+        return y;
+    }
+};
+
+// First-order ADAA for a hard clip at +/-limit
+// Integral of clamp(t) from x[n-1] to x[n], split at the clip points to stay well conditioned
+struct ADAAClamp {
+    float limit = 1.0f;
+    float_4 x1 = 0.0f;
+
+    void init(float l) {
+        limit = l;
+        reset();
+    }
+
+    void reset() {
+        x1 = 0.0f;
+    }
+
+    inline float_4 process(float_4 x) {
+        float_4 c = simd::clamp(x, -limit, limit);
+        float_4 c1 = simd::clamp(x1, -limit, limit);
+        float_4 dx = x - x1;
+
+        float_4 integral = 0.5f * (c - c1) * (c + c1)
+                         + limit * (simd::sgn(x) * (x - c) - simd::sgn(x1) * (x1 - c1));
+        float_4 safeDx = simd::ifelse(simd::fabs(dx) > 1e-3f, dx, 1.0f);
+        float_4 fallback = simd::clamp(0.5f * (x + x1), -limit, limit);
+
+        float_4 y = simd::ifelse(simd::fabs(dx) > 1e-3f, integral / safeDx, fallback);
+        x1 = x;
+        return y;
+    }
+};
+
 // Analog character processor (Shelves-inspired techniques)
+// Runs four lanes at once (two stereo voices per float_4), single precision
 struct SafeAnalogProcessor {
     enum AnalogMode {
         TRANSPARENT = 0,  // Clean digital precision
@@ -237,35 +340,76 @@ struct SafeAnalogProcessor {
         FULL = 3          // Complete circuit modeling with transformer coloration
     };
 
-    double sampleRate = 44100.0;
+    float sampleRate = 44100.0f;
     AnalogMode currentMode = TRANSPARENT;
 
     // State variables (Shelves-inspired)
-    double vca_state = 0.0;
-    double transformer_state_lp = 0.0;
-    double transformer_state_hp = 0.0;
-    double clip_detector_state = 0.0;  // Clipping indicator state
+    float_4 vca_state = 0.0f;
+    float_4 transformer_state_lp = 0.0f;
+    float_4 transformer_state_hp = 0.0f;
+    float_4 clip_detector_state = 0.0f;  // Clipping indicator state
+
+    // Coefficients cached in init() (sample-rate dependent)
+    float hp_cutoff = 0.0f;
+    float lp_cutoff = 0.0f;
+    float clip_alpha_rise = 1.0f;
+    float clip_alpha_fall = 1.0f;
+
+    // Efficient quality: ADAA waveshapers instead of relying on oversampling alone
+    bool adaaEnabled = false;
+    ADAATanh lightShaper, mediumShaper, transformerShaper, outputShaper;
+    ADAAClamp opampClamp;
 
     // Shelves-inspired circuit constants
-    static constexpr double kClampVoltage = 10.5;  // Op-amp saturation from Shelves
-    static constexpr double kVCAGainConstant = -33e-3;  // 2164 VCA gain constant
-    static constexpr double kClipThreshold = 7.0;   // Headroom threshold (3dB to ±10V limit)
+    static constexpr float kClampVoltage = 10.5f;  // Op-amp saturation from Shelves
+    static constexpr float kVCAGainConstant = -33e-3f;  // 2164 VCA gain constant
+    static constexpr float kClipThreshold = 7.0f;   // Headroom threshold (3dB to ±10V limit)
+    static constexpr float kClipLEDRiseTime = 2e-3f;   // 2ms rise time
+    static constexpr float kClipLEDFallTime = 10e-3f;  // 10ms fall time
 
     void init(double sr, AnalogMode mode = TRANSPARENT) {
         sampleRate = sr > 0.0 ? sr : 44100.0;
         currentMode = mode;
-        vca_state = 0.0;
-        transformer_state_lp = transformer_state_hp = 0.0;
-        clip_detector_state = 0.0;
+        vca_state = 0.0f;
+        transformer_state_lp = transformer_state_hp = 0.0f;
+        clip_detector_state = 0.0f;
+
+        // Transformer model: 20Hz highpass, 15kHz gentle rolloff
+        hp_cutoff = 20.0f / sampleRate;
+        lp_cutoff = 15000.0f / sampleRate;
+
+        // Clipping indicator rise/fall (from Shelves)
+        clip_alpha_rise = 1.0f - std::exp(-1.0f / (kClipLEDRiseTime * sampleRate));
+        clip_alpha_fall = 1.0f - std::exp(-1.0f / (kClipLEDFallTime * sampleRate));
+
+        // Drives match the waveshapers below
+        lightShaper.init(1.2f);
+        mediumShaper.init(1.1f);
+        transformerShaper.init(1.05f);
+        outputShaper.init(0.95f);
+        opampClamp.init(kClampVoltage);
     }
 
     void setMode(AnalogMode mode) {
         currentMode = mode;
     }
 
-    inline double process(double input, bool vcaCompressionEnabled = true) {
+    void setADAA(bool enabled) {
+        if (enabled && !adaaEnabled) {
+            // Shaper history is stale while ADAA is off: restart it instead of differencing
+            // against an input that may be seconds old
+            lightShaper.reset();
+            mediumShaper.reset();
+            transformerShaper.reset();
+            outputShaper.reset();
+            opampClamp.reset();
+        }
+        adaaEnabled = enabled;
+    }
+
+    inline float_4 process(float_4 input, bool vcaCompressionEnabled = true) {
         // Stage 1: VCA Compression (if enabled)
-        double signal = vcaCompressionEnabled ? processVCACompression(input) : input;
+        float_4 signal = vcaCompressionEnabled ? processVCACompression(input) : input;
 
         // Stage 2: Analog Character Modeling (based on mode)
         switch (currentMode) {
@@ -290,72 +434,79 @@ struct SafeAnalogProcessor {
 
 private:
     // VCA Compression Stage (separate from analog character modeling)
-    inline double processVCACompression(double input) {
+    inline float_4 processVCACompression(float_4 input) {
         // VCA gain behavior modeling (from Shelves VCA constant)
-        const double vca_gain_constant = -33e-3;  // Shelves-inspired
+        const float vca_gain_constant = -33e-3f;  // Shelves-inspired
 
-        // Soft knee compression/saturation
-        double abs_input = std::abs(input);
-        double compressed = input;
-
-        if (abs_input > 3.0) {  // Above ~3V start gentle compression
-            double excess = abs_input - 3.0;
-            double ratio = 1.0 / (1.0 + excess * 0.3);  // Soft knee
-            compressed = input * ratio;
-        }
+        // Soft knee compression/saturation: above ~3V start gentle compression
+        float_4 abs_input = simd::fabs(input);
+        float_4 ratio = 1.0f / (1.0f + simd::fmax(abs_input - 3.0f, 0.0f) * 0.3f);
+        float_4 compressed = input * ratio;
 
         // Add subtle VCA state-dependent coloration
-        vca_state = vca_state * 0.99 + abs_input * 0.01;  // Envelope following
-        double vca_color = vca_state * vca_gain_constant * 0.1;
+        vca_state = vca_state * 0.99f + abs_input * 0.01f;  // Envelope following
+        float_4 vca_color = vca_state * vca_gain_constant * 0.1f;
 
         return compressed + vca_color;
     }
 
     // Light mode: Subtle harmonic enhancement (2nd/3rd harmonics)
-    inline double processSubtleHarmonics(double input) {
+    inline float_4 processSubtleHarmonics(float_4 input) {
+        if (adaaEnabled) {
+            float_4 linear = lightShaper.mid(input);
+            return 0.75f * linear + 0.25f * lightShaper.process(input);
+        }
+
         // Gentle tanh saturation for 2nd/3rd harmonic content
-        double drive = 1.2;
-        double saturated = std::tanh(input * drive) / drive;
+        const float drive = 1.2f;
+        float_4 saturated = fastTanh(input * drive) / drive;
 
         // Mix with clean signal (75% clean, 25% harmonics)
-        return 0.75 * input + 0.25 * saturated;
+        return 0.75f * input + 0.25f * saturated;
     }
 
     // Medium mode: VCA-style coloration (without compression - that's handled separately)
-    inline double processVCAColoration(double input) {
+    inline float_4 processVCAColoration(float_4 input) {
         // VCA coloration modeling (from Shelves VCA constant)
-        const double vca_gain_constant = -33e-3;  // Shelves-inspired
+        const float vca_gain_constant = -33e-3f;  // Shelves-inspired
 
-        double abs_input = std::abs(input);
+        float_4 abs_input = simd::fabs(input);
 
         // Add VCA state-dependent coloration (no compression here)
-        vca_state = vca_state * 0.99 + abs_input * 0.01;  // Envelope following
-        double vca_color = vca_state * vca_gain_constant * 0.5;  // Increased from 0.2 for more coloration
+        vca_state = vca_state * 0.99f + abs_input * 0.01f;  // Envelope following
+        float_4 vca_color = vca_state * vca_gain_constant * 0.5f;  // Increased from 0.2 for more coloration
+
+        if (adaaEnabled) {
+            float_4 linear = mediumShaper.mid(input);
+            return linear * 0.5f + mediumShaper.process(input) * 0.5f + vca_color;
+        }
 
         // Light saturation for console character
-        double drive = 1.1;
-        double saturated = std::tanh(input * drive) / drive;
+        const float drive = 1.1f;
+        float_4 saturated = fastTanh(input * drive) / drive;
 
-        return input * 0.5 + saturated * 0.5 + vca_color;
+        return input * 0.5f + saturated * 0.5f + vca_color;
     }
 
     // Full mode: Complete circuit modeling (VCA compression handled separately)
-    inline double processFullCircuitModel(double input) {
+    inline float_4 processFullCircuitModel(float_4 input) {
         // Multi-stage analog emulation
-        double signal = input;
+        float_4 signal = input;
 
         // Stage 1: Input transformer coloration
         signal = processTransformerColoration(signal);
 
         // Stage 2: VCA coloration (no compression - handled separately)
-        double abs_input = std::abs(signal);
-        vca_state = vca_state * 0.99 + abs_input * 0.01;  // Envelope following
-        double vca_color = vca_state * kVCAGainConstant * 0.15;
+        float_4 abs_input = simd::fabs(signal);
+        vca_state = vca_state * 0.99f + abs_input * 0.01f;  // Envelope following
+        float_4 vca_color = vca_state * kVCAGainConstant * 0.15f;
         signal += vca_color;
 
         // Stage 3: Op-amp saturation with Shelves clamp voltage
-        if (std::abs(signal) > kClampVoltage) {
-            signal = (signal > 0) ? kClampVoltage : -kClampVoltage;
+        if (adaaEnabled) {
+            signal = opampClamp.process(signal);
+        } else {
+            signal = simd::clamp(signal, -kClampVoltage, kClampVoltage);
         }
 
         // Stage 4: Clipping detection (Shelves-inspired)
@@ -368,62 +519,57 @@ private:
     }
 
     // Transformer coloration modeling
-    inline double processTransformerColoration(double input) {
+    inline float_4 processTransformerColoration(float_4 input) {
         // Simple transformer model: high-pass + low-pass for frequency response
-        // Based on Shelves transformer behavior
-        const double hp_cutoff = 20.0 / sampleRate;  // 20Hz highpass
-        const double lp_cutoff = 15000.0 / sampleRate;  // 15kHz gentle rolloff
+        // Based on Shelves transformer behavior (cutoffs cached in init)
 
         // High-pass (DC blocking)
-        transformer_state_hp = transformer_state_hp * (1.0 - hp_cutoff) + input * hp_cutoff;
-        double hp_out = input - transformer_state_hp;
+        transformer_state_hp = transformer_state_hp * (1.0f - hp_cutoff) + input * hp_cutoff;
+        float_4 hp_out = input - transformer_state_hp;
 
         // Low-pass (high frequency rolloff)
         transformer_state_lp += (hp_out - transformer_state_lp) * lp_cutoff;
 
         // Add subtle harmonic distortion
-        double drive = 1.05;
-        return std::tanh(transformer_state_lp * drive) / drive;
+        if (adaaEnabled) {
+            return transformerShaper.process(transformer_state_lp);
+        }
+        const float drive = 1.05f;
+        return fastTanh(transformer_state_lp * drive) / drive;
     }
 
 public:
     // Clipping detection (Shelves-inspired)
-    inline void updateClippingDetector(double signal) {
-        // Clipping indicator with rise/fall time constants (from Shelves)
-        const double kClipLEDRiseTime = 2e-3;   // 2ms rise time
-        const double kClipLEDFallTime = 10e-3;  // 10ms fall time
-
-        double abs_signal = std::abs(signal);
-        bool clipping = abs_signal > kClipThreshold;
-
-        if (clipping) {
-            // Fast rise
-            double alpha_rise = 1.0 - std::exp(-1.0 / (kClipLEDRiseTime * sampleRate));
-            clip_detector_state += alpha_rise * (1.0 - clip_detector_state);
-        } else {
-            // Slow fall
-            double alpha_fall = 1.0 - std::exp(-1.0 / (kClipLEDFallTime * sampleRate));
-            clip_detector_state -= alpha_fall * clip_detector_state;
-        }
-
-        clip_detector_state = std::max(0.0, std::min(1.0, clip_detector_state));
+    inline void updateClippingDetector(float_4 signal) {
+        // Fast rise while above threshold, slow fall otherwise
+        float_4 clipping = simd::fabs(signal) > kClipThreshold;
+        float_4 target = clipping & float_4(1.0f);
+        float_4 alpha = simd::ifelse(clipping, float_4(clip_alpha_rise), float_4(clip_alpha_fall));
+        clip_detector_state += alpha * (target - clip_detector_state);
+        clip_detector_state = simd::clamp(clip_detector_state, 0.0f, 1.0f);
     }
 
-public:
-    // Get clipping indicator state (0.0 to 1.0)
-    inline double getClippingLevel() const {
-        return clip_detector_state;
+    // Get clipping indicator state (0.0 to 1.0), loudest lane
+    inline float getClippingLevel() const {
+        return std::max(std::max(clip_detector_state[0], clip_detector_state[1]),
+                        std::max(clip_detector_state[2], clip_detector_state[3]));
     }
 
     // Output transformer with saturation
-    inline double processOutputTransformer(double input) {
+    inline float_4 processOutputTransformer(float_4 input) {
+        // Add transformer frequency response (subtle)
+        const float transformer_color = 0.02f;
+
+        if (adaaEnabled) {
+            float_4 linear = outputShaper.mid(input);
+            return linear * (1.0f - transformer_color) + outputShaper.process(input) * transformer_color;
+        }
+
         // Output transformer saturation curve
-        double drive = 0.95;
-        double saturated = std::tanh(input * drive) / drive;
+        const float drive = 0.95f;
+        float_4 saturated = fastTanh(input * drive) / drive;
 
-        // Add transformer frequency response (subtle)
-        const double transformer_color = 0.02;
-        return input * (1.0 - transformer_color) + saturated * transformer_color;
+        return input * (1.0f - transformer_color) + saturated * transformer_color;
     }
 };
 
@@ -564,6 +710,50 @@ public:
         return in;
     }
 
+    // Section-major block processing (in place): each section runs over the
+    // whole buffer with its coefficients and state held in locals
+    void ProcessBlock(T* buffer, int size)
+    {
+        // Input history of the current section, as it was before this block
+        T in1 = x_[0][0];
+        T in2 = x_[0][1];
+
+        for (int n = 0; n < num_sections_; n++)
+        {
+            const float b0 = sections_[n].b[0];
+            const float b1 = sections_[n].b[1];
+            const float b2 = sections_[n].b[2];
+            const float a0 = sections_[n].a[0];
+            const float a1 = sections_[n].a[1];
+
+            T out1 = x_[n+1][0];
+            T out2 = x_[n+1][1];
+
+            // Output history is the next section's input history
+            T nextIn1 = out1;
+            T nextIn2 = out2;
+
+            for (int i = 0; i < size; i++)
+            {
+                T in = buffer[i];
+                T out = b0 * in + b1 * in1 + b2 * in2 - a0 * out1 - a1 * out2;
+                in2 = in1;
+                in1 = in;
+                out2 = out1;
+                out1 = out;
+                buffer[i] = out;
+            }
+
+            x_[n][0] = in1;
+            x_[n][1] = in2;
+            x_[n+1][0] = out1;
+            x_[n+1][1] = out2;
+
+            in1 = nextIn1;
+            in2 = nextIn2;
+        }
+    }
+
 protected:
     int num_sections_;
     SOSCoefficients sections_[max_num_sections];
@@ -584,6 +774,16 @@ public:
         return filter_.Process(in);
     }
 
+    void ProcessBlock(T* buffer, int size)
+    {
+        filter_.ProcessBlock(buffer, size);
+    }
+
+    void Reset()
+    {
+        filter_.Reset();
+    }
+
 protected:
     SOSFilter<T, kMaxNumSections> filter_;
 
@@ -959,6 +1159,444 @@ class DownsamplingAAFilter : public AAFilter<T>
     }
 };
 
+// Zeroth-order modified Bessel function (Kaiser window)
+inline double BesselI0(double x)
+{
+    double sum = 1.0, term = 1.0;
+    for (int k = 1; k < 32; k++)
+    {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum += term;
+    }
+    return sum;
+}
+
+// One 2x polyphase halfband stage: Kaiser-windowed sinc of odd length 4K-1
+// Apart from the 0.5 centre tap only the even taps are non-zero, so the filtering
+// branch has 2K taps and the other branch is a pure delay
+template <typename T>
+class HalfbandStage
+{
+public:
+    static constexpr int kMaxBranchTaps = 32;  // Filter length 63
+
+    void Init(int length, double beta)
+    {
+        branch_taps_ = (length + 1) / 2;
+        delay_ = branch_taps_ / 2 - 1;
+        const int centre = (length - 1) / 2;
+        double sum = 0.0;
+        for (int k = 0; k < branch_taps_; k++)
+        {
+            double t = 0.5 * (2 * k - centre);  // Odd offsets from the centre, in input samples
+            double r = (2.0 * k - centre) / centre;
+            double window = BesselI0(beta * std::sqrt(std::max(0.0, 1.0 - r * r))) / BesselI0(beta);
+            double h = std::sin(M_PI * t) / (2.0 * M_PI * t) * window;
+            taps_[k] = h;
+            sum += h;
+        }
+        for (int k = 0; k < branch_taps_; k++)
+        {
+            taps_[k] *= 0.5 / sum;  // Unity DC gain together with the centre tap
+        }
+        Reset();
+    }
+
+    void Reset()
+    {
+        for (int i = 0; i < 2 * kMaxBranchTaps; i++)
+        {
+            even_[i] = 0.f;
+            odd_[i] = 0.f;
+        }
+        even_pos_ = 0;
+        odd_pos_ = 0;
+    }
+
+    // One input sample to two output samples (zero-stuffing gain included)
+    void Interpolate(T in, T* out)
+    {
+        Push(even_, even_pos_, in);
+        out[0] = 2.f * Branch(&even_[even_pos_]);
+        out[1] = even_[even_pos_ + delay_];
+    }
+
+    // Two input samples to one output sample
+    T Decimate(T in0, T in1)
+    {
+        Push(even_, even_pos_, in0);
+        Push(odd_, odd_pos_, in1);
+        return Branch(&odd_[odd_pos_]) + 0.5f * even_[even_pos_ + delay_];
+    }
+
+private:
+    int branch_taps_ = 1;
+    int delay_ = 0;
+    float taps_[kMaxBranchTaps] = {};
+    // Mirrored histories: [pos, pos + branch_taps_) is always contiguous, newest first
+    T even_[2 * kMaxBranchTaps];
+    T odd_[2 * kMaxBranchTaps];
+    int even_pos_ = 0;
+    int odd_pos_ = 0;
+
+    void Push(T* history, int& pos, T in)
+    {
+        pos = (pos == 0 ? branch_taps_ : pos) - 1;
+        history[pos] = in;
+        history[pos + branch_taps_] = in;
+    }
+
+    T Branch(const T* history) const
+    {
+        T acc = 0.f;
+        for (int k = 0; k < branch_taps_; k++)
+        {
+            acc += taps_[k] * history[k];
+        }
+        return acc;
+    }
+};
+
+// 2x/4x/8x oversampling as a cascade of halfband stages
+// The first stage (nearest the host rate) sets the quality; later stages see the
+// audio band as a small fraction of their rate and use shorter filters
+template <typename T>
+class HalfbandOversampler
+{
+public:
+    static constexpr int kMaxStages = 3;
+
+    void Init(int factor, bool long_filters)
+    {
+        num_stages_ = (factor >= 8) ? 3 : (factor >= 4) ? 2 : 1;
+        for (int s = 0; s < num_stages_; s++)
+        {
+            int length = (s == 0) ? (long_filters ? 63 : 31) : (long_filters ? 23 : 19);
+            double beta = long_filters ? 10.06 : 7.86;  // ~100dB / ~80dB stopband
+            up_[s].Init(length, beta);
+            down_[s].Init(length, beta);
+        }
+    }
+
+    void Reset()
+    {
+        for (int s = 0; s < num_stages_; s++)
+        {
+            up_[s].Reset();
+            down_[s].Reset();
+        }
+    }
+
+    // One host sample to factor oversampled samples
+    void Upsample(T in, T* block)
+    {
+        T scratch[1 << kMaxStages];
+        block[0] = in;
+        int size = 1;
+        for (int s = 0; s < num_stages_; s++)
+        {
+            for (int i = 0; i < size; i++)
+            {
+                up_[s].Interpolate(block[i], &scratch[2 * i]);
+            }
+            size *= 2;
+            for (int i = 0; i < size; i++)
+            {
+                block[i] = scratch[i];
+            }
+        }
+    }
+
+    // factor oversampled samples to one host sample (block is used as scratch)
+    T Downsample(T* block)
+    {
+        int size = 1 << num_stages_;
+        for (int s = num_stages_ - 1; s >= 0; s--)
+        {
+            size /= 2;
+            for (int i = 0; i < size; i++)
+            {
+                block[i] = down_[s].Decimate(block[2 * i], block[2 * i + 1]);
+            }
+        }
+        return block[0];
+    }
+
+private:
+    int num_stages_ = 1;
+    HalfbandStage<T> up_[kMaxStages];
+    HalfbandStage<T> down_[kMaxStages];
+};
+
+// Per-group state of one SVF band (two stereo voices per float_4)
+struct SVFState {
+    float_4 ic1 = 0.0f;
+    float_4 ic2 = 0.0f;
+
+    void reset() {
+        ic1 = 0.0f;
+        ic2 = 0.0f;
+    }
+};
+
+// Mid/side on a voice group: [L0, R0, L1, R1] <-> [M0, S0, M1, S1]
+// M = (L + R) / 2, S = (L - R) / 2, decoded as L = M + S, R = M - S
+inline float_4 midSideEncode(float_4 x) {
+    return 0.5f * (float_4(x[1], x[0], x[3], x[2]) + x * float_4(1.0f, -1.0f, 1.0f, -1.0f));
+}
+
+inline float_4 midSideDecode(float_4 x) {
+    return float_4(x[1], x[0], x[3], x[2]) + x * float_4(1.0f, -1.0f, 1.0f, -1.0f);
+}
+
+// Trapezoidal state-variable filter band (Simper/Cytomic topology)
+// - Same bilinear responses as dsp::TBiquadFilter, including its shelf/peak V convention
+// - Scalar coefficients shared by all voice groups; state lives in SVFState
+// - g, k and the output mix glide linearly to new targets one step per host sample,
+//   so sweeps don't zipper and targets only need recomputing when parameters change
+struct SVFBand {
+    enum Type {
+        LOWPASS,
+        HIGHPASS,
+        LOWSHELF,
+        HIGHSHELF,
+        PEAK,
+        BANDPASS  // Unity peak gain (dynamic band detectors)
+    };
+
+    struct Coefficients {
+        float g = 0.0f;   // tan(pi * fc)
+        float k = 1.0f;   // damping (1/Q)
+        float m0 = 1.0f;  // input mix
+        float m1 = 0.0f;  // band-pass mix
+        float m2 = 0.0f;  // low-pass mix
+    };
+
+    Coefficients current, target, step;
+    int rampRemaining = 0;
+
+    // Derived from current g and k (refreshed only while gliding)
+    float a1 = 1.0f, a2 = 0.0f, a3 = 0.0f;
+
+    static Coefficients design(Type type, float fc, float Q, float V) {
+        Coefficients c;
+        float K = std::tan(M_PI * fc);
+        c.g = K;
+        switch (type) {
+            case LOWPASS:
+                c.k = 1.0f / Q;
+                c.m0 = 0.0f; c.m1 = 0.0f; c.m2 = 1.0f;
+                break;
+            case HIGHPASS:
+                c.k = 1.0f / Q;
+                c.m0 = 1.0f; c.m1 = -c.k; c.m2 = -1.0f;
+                break;
+            case LOWSHELF:
+                // Fixed Butterworth slope; cut mirrors boost by moving the corner down
+                c.k = M_SQRT2;
+                c.g = (V >= 1.0f) ? K : K / std::sqrt(V);
+                c.m0 = 1.0f;
+                c.m1 = std::sqrt(2.0f * V) - (float)M_SQRT2;
+                c.m2 = V - 1.0f;
+                break;
+            case HIGHSHELF:
+                c.k = M_SQRT2;
+                c.g = (V >= 1.0f) ? K : K * std::sqrt(V);
+                c.m0 = V;
+                c.m1 = std::sqrt(2.0f * V) - V * (float)M_SQRT2;
+                c.m2 = 1.0f - V;
+                break;
+            case BANDPASS:
+                c.k = 1.0f / Q;
+                c.m0 = 0.0f; c.m1 = c.k; c.m2 = 0.0f;
+                break;
+            case PEAK:
+            default:
+                // Boost widens with V on the numerator, cut on the denominator
+                c.k = (V >= 1.0f) ? 1.0f / Q : 1.0f / (Q * V);
+                c.m0 = 1.0f;
+                c.m1 = c.k * (V - 1.0f);
+                c.m2 = 0.0f;
+                break;
+        }
+        return c;
+    }
+
+    // Magnitude-matched design (Vicanek): impulse-invariant poles, numerator fitted to the
+    // analog prototype's magnitude at DC, Nyquist and the natural frequency, so bells and
+    // shelves keep their analog shape up to Nyquist instead of cramping
+    // The matched biquad is converted back to SVF coefficients (same per-sample code)
+    static Coefficients designMatched(Type type, float fc, float Q, float V) {
+        Coefficients c = design(type, fc, Q, V);
+        double scale = c.g / std::tan(M_PI * fc);  // Shelves move their corner with V
+        double wn = 2.0 * M_PI * fc * scale;
+        if (wn >= 0.9 * M_PI) return c;  // Too close to Nyquist to fit
+
+        // Impulse-invariant poles of s^2 + k s + 1
+        double zeta = 0.5 * c.k;
+        double r = std::exp(-zeta * wn);
+        double a1 = (zeta < 1.0) ? -2.0 * r * std::cos(wn * std::sqrt(1.0 - zeta * zeta))
+                                 : -2.0 * r * std::cosh(wn * std::sqrt(zeta * zeta - 1.0));
+        double a2 = r * r;
+
+        // Squared analog magnitude at digital frequency w (rad/sample)
+        auto analog2 = [&](double w) {
+            std::complex<double> s(0.0, w / wn);
+            return std::norm((double)c.m0 + ((double)c.m1 * s + (double)c.m2) / (s * s + (double)c.k * s + 1.0));
+        };
+
+        double A0 = (1.0 + a1 + a2) * (1.0 + a1 + a2);
+        double A1 = (1.0 - a1 + a2) * (1.0 - a1 + a2);
+        double A2 = -4.0 * a2;
+        double phi1 = std::sin(0.5 * wn) * std::sin(0.5 * wn);
+        double phi0 = 1.0 - phi1;
+        double phi2 = 4.0 * phi0 * phi1;
+
+        double B0 = A0 * analog2(0.0);
+        double B1 = A1 * analog2(M_PI);
+        double B2 = (analog2(wn) * (A0 * phi0 + A1 * phi1 + A2 * phi2) - B0 * phi0 - B1 * phi1) / phi2;
+
+        double W = 0.5 * (std::sqrt(B0) + std::sqrt(B1));
+        double disc = W * W + B2;
+        if (disc < 0.0) return c;
+        double b0 = 0.5 * (W + std::sqrt(disc));
+        double b1 = 0.5 * (std::sqrt(B0) - std::sqrt(B1));
+        double b2 = -B2 / (4.0 * b0);
+
+        // Biquad to SVF: s = (1/g)(z - 1)/(z + 1) maps both forms onto each other
+        double dcDen = 1.0 + a1 + a2;
+        double nyqDen = 1.0 - a1 + a2;
+        double g = std::sqrt(dcDen / nyqDen);
+        double k = 2.0 * (1.0 - a2) / nyqDen / g;
+        Coefficients m;
+        m.g = g;
+        m.k = k;
+        m.m0 = (b0 - b1 + b2) / nyqDen;
+        m.m2 = (b0 + b1 + b2) / dcDen - m.m0;
+        m.m1 = (b0 - b2) * (1.0 + g * k + g * g) / (2.0 * g) - m.m0 * k;
+        return m;
+    }
+
+    // Magnitude at a prewarped frequency w = tan(pi * f / sampleRate)
+    static double magnitude(const Coefficients& c, double w) {
+        std::complex<double> s(0.0, w / c.g);
+        return std::abs((double)c.m0 + ((double)c.m1 * s + (double)c.m2) / (s * s + (double)c.k * s + 1.0));
+    }
+
+    // Glide to new coefficients over rampSamples host samples (0 = jump)
+    void setTarget(const Coefficients& c, int rampSamples) {
+        target = c;
+        if (rampSamples <= 0) {
+            current = c;
+            rampRemaining = 0;
+            updateDerived();
+            return;
+        }
+        float inv = 1.0f / rampSamples;
+        step.g = (c.g - current.g) * inv;
+        step.k = (c.k - current.k) * inv;
+        step.m0 = (c.m0 - current.m0) * inv;
+        step.m1 = (c.m1 - current.m1) * inv;
+        step.m2 = (c.m2 - current.m2) * inv;
+        rampRemaining = rampSamples;
+    }
+
+    // Advance the glide by one host sample
+    inline void tick() {
+        if (rampRemaining <= 0) return;
+        if (--rampRemaining == 0) {
+            current = target;
+        } else {
+            current.g += step.g;
+            current.k += step.k;
+            current.m0 += step.m0;
+            current.m1 += step.m1;
+            current.m2 += step.m2;
+        }
+        updateDerived();
+    }
+
+    inline void updateDerived() {
+        a1 = 1.0f / (1.0f + current.g * (current.g + current.k));
+        a2 = current.g * a1;
+        a3 = current.g * a2;
+    }
+
+    // Run one group over a block in place, coefficients and state held in locals
+    inline void processBlock(SVFState& state, float_4* buffer, int size) const {
+        run(state, buffer, size, a1, a2, a3, current.m0, current.m1, current.m2);
+    }
+
+    // Same, with this band on the even lanes and another on the odd lanes (mid/side)
+    inline void processBlock(const SVFBand& odd, SVFState& state, float_4* buffer, int size) const {
+        run(state, buffer, size,
+            float_4(a1, odd.a1, a1, odd.a1), float_4(a2, odd.a2, a2, odd.a2), float_4(a3, odd.a3, a3, odd.a3),
+            float_4(current.m0, odd.current.m0, current.m0, odd.current.m0),
+            float_4(current.m1, odd.current.m1, current.m1, odd.current.m1),
+            float_4(current.m2, odd.current.m2, current.m2, odd.current.m2));
+    }
+
+    static inline void run(SVFState& state, float_4* buffer, int size,
+                           const float_4 A1, const float_4 A2, const float_4 A3,
+                           const float_4 M0, const float_4 M1, const float_4 M2) {
+        float_4 ic1 = state.ic1, ic2 = state.ic2;
+
+        for (int i = 0; i < size; i++) {
+            float_4 v0 = buffer[i];
+            float_4 v3 = v0 - ic2;
+            float_4 v1 = A1 * ic1 + A2 * v3;
+            float_4 v2 = ic2 + A2 * ic1 + A3 * v3;
+            ic1 = 2.0f * v1 - ic1;
+            ic2 = 2.0f * v2 - ic2;
+            buffer[i] = M0 * v0 + M1 * v1 + M2 * v2;
+        }
+
+        state.ic1 = ic1;
+        state.ic2 = ic2;
+    }
+};
+
+// Dynamic band detector: band-passed peak envelope at the band's frequency and Q
+// Below the threshold the band stays flat; the full gain setting is reached RANGE_DB above it
+struct DynamicBandDetector {
+    static constexpr float RANGE_DB = 12.0f;
+
+    SVFBand filter;
+    float envelope = 0.0f;
+    float attackCoeff = 0.0f;
+    float releaseCoeff = 0.0f;
+    float lastF0 = -1.0f;
+    float lastQ = -1.0f;
+
+    void init(double sampleRate) {
+        attackCoeff = 1.0f - std::exp(-1.0f / (0.005f * sampleRate));   // 5ms
+        releaseCoeff = 1.0f - std::exp(-1.0f / (0.100f * sampleRate));  // 100ms
+        envelope = 0.0f;
+        lastF0 = -1.0f;
+        lastQ = -1.0f;
+    }
+
+    // Control rate: follow the band's frequency and Q (glides like the bands)
+    void setBand(float f0, float Q, double sampleRate, int rampSamples) {
+        if (f0 == lastF0 && Q == lastQ) return;
+        float fc = std::min(f0 / (float)sampleRate, 0.45f);
+        filter.setTarget(SVFBand::design(SVFBand::BANDPASS, fc, Q, 1.0f), lastF0 < 0.0f ? 0 : rampSamples);
+        lastF0 = f0;
+        lastQ = Q;
+    }
+
+    // Per sample: peak level of the band-passed input across all lanes
+    inline void update(float level) {
+        envelope += (level - envelope) * (level > envelope ? attackCoeff : releaseCoeff);
+    }
+
+    // Fraction of the gain setting to apply (0 = flat, 1 = full setting); 0dBFS = 5V
+    float amount(float thresholdDb) const {
+        float levelDb = 20.0f * std::log10(std::max(envelope, 1e-6f) / 5.0f);
+        return clamp((levelDb - thresholdDb) / RANGE_DB, 0.0f, 1.0f);
+    }
+};
+
 // Sophisticated 2x oversampler with FIR anti-aliasing filters (NO std::vector)
 struct SafeOversampler2x {
     static constexpr int FILTER_ORDER = 8;
@@ -1082,6 +1720,13 @@ struct BypassParamQuantity : ParamQuantity {
     }
 };
 
+// Expander message struct for C1EQCV (EQ-X) communication
+struct C1EQExpanderMessage {
+    float freqCV[4];  // Octaves (1V/oct, attenuated)
+    float gainCV[4];  // -1.0 to +1.0 (attenuated)
+    float qCV[4];     // -1.0 to +1.0 (attenuated, bands 2 & 3 only)
+};
+
 struct C1EQ : Module {
     enum ParamIds {
         GLOBAL_GAIN_PARAM,
@@ -1099,6 +1744,13 @@ struct C1EQ : Module {
         BYPASS_PARAM,
         ANALOG_MODE_PARAM,  // 4-position analog character selector
         ANALYSER_ENABLE_PARAM,  // Enable/disable spectrum analyser
+        // Side band settings for M/S mode (context menu), same order as B1_FREQ..B4_MODE
+        S_B1_FREQ_PARAM, S_B1_GAIN_PARAM,
+        S_B2_FREQ_PARAM, S_B2_Q_PARAM, S_B2_GAIN_PARAM,
+        S_B3_FREQ_PARAM, S_B3_Q_PARAM, S_B3_GAIN_PARAM,
+        S_B4_FREQ_PARAM, S_B4_GAIN_PARAM,
+        S_B1_MODE_PARAM,
+        S_B4_MODE_PARAM,
         NUM_PARAMS
     };
 
@@ -1124,13 +1776,55 @@ struct C1EQ : Module {
         NUM_LIGHTS
     };
 
+    // Polyphony: up to 16 stereo voices, two voices per float_4 group
+    // Group lane layout: [L(2g), R(2g), L(2g+1), R(2g+1)]
+    static constexpr int MAX_CHANNELS = 16;
+    static constexpr int NUM_GROUPS = MAX_CHANNELS / 2;
+    int activeGroups = 0;
+
     // SIMD-optimized stereo DSP objects (Bandit pattern)
-    dsp::TBiquadFilter<float_4> bands[4][2];     // [band][L/R] - dual stereo as float_4 SIMD
+    // One SVF per band with shared coefficients; float_4 state per band and group
+    SVFBand bands[4];
+    SVFState bandStates[4][NUM_GROUPS];
+
+    // Mid/side mode: groups carry [M(2g), S(2g), M(2g+1), S(2g+1)] through the bands,
+    // side coefficients run on the odd lanes of the same filters (band set 1 = side)
+    static constexpr int SIDE_PARAM_OFFSET = S_B1_FREQ_PARAM - B1_FREQ_PARAM;
+    bool midSideMode = false;
+    bool appliedMidSideMode = false;
+    SVFBand sideBands[4];
+
+    // Sparse band execution: neutral bands (0dB bell/shelf, cut parked at 20Hz/20kHz) are
+    // skipped; switching crossfades against the dry signal, the band keeps running while fading
+    static constexpr int BAND_FADE_SAMPLES = 64;
+    bool bandNeutral[2][4] = {};  // Per band set (stereo/mid, side)
+    float bandMix[4] = {1.0f, 1.0f, 1.0f, 1.0f};  // 0 = skipped, 1 = fully in the chain
+
+    // Dynamic EQ for bands 2 and 3 (context menu): detectors shared by all voices
+    bool dynamicEnabled[2] = {false, false};
+    float dynamicThresholdDb[2] = {-20.0f, -20.0f};
+    DynamicBandDetector dynamicDetectors[2];
+    SVFState dynamicStates[2][NUM_GROUPS];
+    double hostSampleRate = 44100.0;
+
+    // Response-curve snapshot for the display: written by the audio thread only when a band
+    // is redesigned or the master gain moves, read by the UI thread (seqlock, odd = writing)
+    struct ResponseSnapshot {
+        SVFBand::Coefficients bands[4];
+        SVFBand::Coefficients sideBands[4];
+        bool midSide = false;
+        float sampleRate = 44100.0f;  // Rate the coefficients were designed for
+        float masterGainDb = 0.0f;
+    };
+    ResponseSnapshot responseSnapshot;
+    std::atomic<uint32_t> responseSequence{0};
+    bool responseDirty = true;
+    bool showResponseCurve = true;  // Context menu: draw the EQ curve over the analyzer
 
     // SAFE: Parameter smoothers (shared for stereo-linked processing)
-    SafeParamSmoother freqSmoothers[4];
-    SafeParamSmoother qSmoothers[4];
-    SafeParamSmoother gainSmoothers[4];
+    SafeParamSmoother freqSmoothers[2][4];  // Per band set (stereo/mid, side)
+    SafeParamSmoother qSmoothers[2][4];
+    SafeParamSmoother gainSmoothers[2][4];
     SafeParamSmoother globalGainSmoother;
 
     // SAFE: Coefficient caches (fixed arrays)
@@ -1139,18 +1833,27 @@ struct C1EQ : Module {
         int mode = -1;  // Include mode in cache
         double sampleRate = -1;  // Include sample rate in cache (critical for oversampling)
     };
-    BandCache bandCache[4];
+    BandCache bandCache[2][4];  // Per band set (stereo/mid, side)
 
     // Oversampling (Shelves approach)
     static constexpr int OVERSAMPLING_FACTOR = 4;
+    static constexpr int MAX_OVERSAMPLING = 16;  // Block buffer size (largest factor is 15 at 8kHz)
     int oversampling_ = OVERSAMPLING_FACTOR;
 
-    // Shelves anti-aliasing filters (copied exact structure)
-    UpsamplingAAFilter<float> up_filter_[3];      // 3 upsampling filters
-    DownsamplingAAFilter<float> down_filter_[2];  // 2 downsampling filters
+    // Shelves anti-aliasing filters (one float_4 filter per voice group)
+    UpsamplingAAFilter<float_4> up_filter_[NUM_GROUPS];
+    DownsamplingAAFilter<float_4> down_filter_[NUM_GROUPS];
 
-    // SAFE: Analog character processors (stereo)
-    SafeAnalogProcessor analogProcessorL, analogProcessorR;
+    // Explicit oversampling factor (context menu): 0 = Auto (Shelves factor and filters),
+    // 1-3 = 2x/4x/8x halfband cascade with short (0) or long (1) filters
+    int oversamplingChoice = 0;
+    int oversamplingQuality = 0;
+    int appliedOversamplingChoice = -1;   // Audio thread: settings the filters were built for
+    int appliedOversamplingQuality = -1;
+    HalfbandOversampler<float_4> halfband_[NUM_GROUPS];
+
+    // SAFE: Analog character processors (one float_4 processor per voice group)
+    SafeAnalogProcessor analogProcessors[NUM_GROUPS];
 
     // Real oversampling implementation
     SafeOversampler2x oversampler;
@@ -1158,18 +1861,63 @@ struct C1EQ : Module {
     // VCA compression control (context menu)
     bool vcaCompressionEnabled = false;  // Default: disabled (user must enable)
     bool enableProportionalQ = true;   // Default: enabled for musical response
+    int analyzerSource = 0;            // 0 = sum of all voices, 1-16 = single voice
+    bool efficientAnalogMode = false;  // ADAA waveshapers (analog character without heavy oversampling)
+    bool matchedHighBands = false;     // Matched (cramping-free) design for B3/B4 bell and shelf
+    bool appliedMatchedHighBands = false;
+
+    // Linear-phase mode (context menu): bands replaced by a symmetric FIR, oversampling bypassed
+    // The engine is allocated on first use (large convolution buffers) and published to the
+    // audio thread with release before the flag; it is only deleted with the module
+    std::atomic<bool> linearPhaseEnabled{false};
+    int linearPhasePartition = LinearPhaseEngine::DEFAULT_PARTITION_SIZE;
+    std::atomic<LinearPhaseEngine*> linearPhase{nullptr};
+    LinearPhaseEngine* activeLinearPhase = nullptr;  // Audio thread: engine loaded (acquire) per process()
+    bool linearPhaseRunning = false;             // Audio thread: engine state is live
+    bool linearPhaseSubmitted = false;           // Audio thread: current band targets sent to the worker
+    static constexpr float LINEAR_PHASE_DESIGN_INTERVAL = 0.05f;  // Seconds between FIR redesigns
+    float linearPhaseDesignAge = 0.0f;           // Audio thread: seconds since the last design request
+
+    // Linear-phase mode: the analyzer's input (pre) feed is delayed by the FIR latency so the
+    // input/difference views compare the same stretch of audio as the delayed output
+    static constexpr int ANALYZER_DELAY_SIZE = 8192;  // Power of two
+    static_assert(ANALYZER_DELAY_SIZE > LinearPhaseEngine::LATENCY_TAPS + LinearPhaseEngine::MAX_PARTITION_SIZE,
+                  "analyzer input delay shorter than the linear-phase latency");
+    float analyzerInputDelay[2][ANALYZER_DELAY_SIZE] = {};
+    int analyzerDelayPos = 0;
+    SVFBand::Coefficients linearPhaseSent[4];
 
     // Spectrum analysis for display
     EqAnalysisEngine* spectrumAnalyzer = nullptr;
     std::atomic<bool> isShuttingDown{false};  // Thread safety: prevent access during destruction
 
+    // Analyzer resolution (context menu), pushed to the engine by applyAnalyzerSettings()
+    int analyzerFFTSize = 1;                                  // Index: 1024 << i (default 2048)
+    int analyzerWindow = EqAnalysisEngine::WINDOW_HANN;
+    int analyzerOverlap = EqAnalysisEngine::DEFAULT_OVERLAP;  // 0 = none, 1 = 50%, 2 = 75%
+    int analyzerAveraging = 0;                                // 0 = off, 1 = fast, 2 = slow
+    int analyzerView = 0;                                     // 0 = output, 1 = input + output, 2 = difference
+    int analyzerSmoothing = EqAnalysisEngine::SMOOTHING_OFF;
+    bool analyzerMultirate = false;                           // Decimated FFTs for low-frequency detail
+
     // Analyzer auto-shutdown state
     float analyzerIdleTimer = 0.0f;      // Counts time since display OFF
     bool analyzerDSPActive = true;        // Track worker thread state
 
+    // Analyzer visibility: the display publishes the time it was last drawn (UI thread),
+    // the audio thread polls it and skips analysis while the display is not on screen
+    // (scrolled away, zoomed far out or window minimized)
+    static constexpr float ANALYZER_VISIBLE_TIMEOUT = 0.25f;  // Seconds without a draw
+    static constexpr int VISIBILITY_CHECK_INTERVAL = 512;     // Frames between polls
+    std::atomic<double> analyzerDrawTime{-1.0};
+    bool analyzerVisible = true;
+    int visibilityCheckCounter = 0;
+
     dsp::ClockDivider lightDivider;       // LED update clock divider (update every 256 samples)
 
     // Coefficient update clock divider (update every 16 samples for efficiency)
+    // Band coefficients glide to each new target over the same interval
+    static constexpr int COEFFICIENT_INTERVAL = 16;
     int coefficientDivider = 0;
 
     // Event-based mode tracking for Cut mode gain lock
@@ -1212,6 +1960,22 @@ struct C1EQ : Module {
         configParam<ModeParamQuantity>(B4_MODE_PARAM, 0.f, 2.f, 2.f, "High Mode");
         getParamQuantity(B4_MODE_PARAM)->snapEnabled = true;
 
+        // Side bands (M/S mode): same ranges and defaults as the panel bands
+        configParam(S_B1_FREQ_PARAM, std::log2(20.0f), std::log2(400.0f), std::log2(20.0f), "Side Low Freq", " Hz", 2.0f);
+        configParam(S_B1_GAIN_PARAM, -20.f, 20.f, 0.f, "Side Low Gain", " dB");
+        configParam<ModeParamQuantity>(S_B1_MODE_PARAM, 0.f, 2.f, 2.f, "Side Low Mode");
+        getParamQuantity(S_B1_MODE_PARAM)->snapEnabled = true;
+        configParam(S_B2_FREQ_PARAM, std::log2(200.0f), std::log2(2000.0f), std::log2(250.0f), "Side Low-Mid Freq", " Hz", 2.0f);
+        configParam(S_B2_Q_PARAM, 0.3f, 12.f, 1.0f, "Side Low-Mid Q");
+        configParam(S_B2_GAIN_PARAM, -20.f, 20.f, 0.f, "Side Low-Mid Gain", " dB");
+        configParam(S_B3_FREQ_PARAM, std::log2(1000.0f), std::log2(8000.0f), std::log2(2000.0f), "Side High-Mid Freq", " Hz", 2.0f);
+        configParam(S_B3_Q_PARAM, 0.3f, 12.f, 1.0f, "Side High-Mid Q");
+        configParam(S_B3_GAIN_PARAM, -20.f, 20.f, 0.f, "Side High-Mid Gain", " dB");
+        configParam(S_B4_FREQ_PARAM, std::log2(4000.0f), std::log2(20000.0f), std::log2(20000.0f), "Side High Freq", " Hz", 2.0f);
+        configParam(S_B4_GAIN_PARAM, -20.f, 20.f, 0.f, "Side High Gain", " dB");
+        configParam<ModeParamQuantity>(S_B4_MODE_PARAM, 0.f, 2.f, 2.f, "Side High Mode");
+        getParamQuantity(S_B4_MODE_PARAM)->snapEnabled = true;
+
         // Configure inputs/outputs
         configInput(AUDIO_INPUT_L, "Audio Left");
         configInput(AUDIO_INPUT_R, "Audio Right");
@@ -1237,6 +2001,27 @@ struct C1EQ : Module {
         // Reset context menu settings to defaults
         vcaCompressionEnabled = false;  // Off (default disabled)
         enableProportionalQ = true;     // On (matches default at line 1194)
+        analyzerSource = 0;             // Sum of all voices
+        analyzerFFTSize = 1;            // 2048 points, Hann, 50% overlap
+        analyzerWindow = EqAnalysisEngine::WINDOW_HANN;
+        analyzerOverlap = EqAnalysisEngine::DEFAULT_OVERLAP;
+        analyzerAveraging = 0;
+        analyzerView = 0;               // Output spectrum only
+        analyzerSmoothing = EqAnalysisEngine::SMOOTHING_OFF;
+        analyzerMultirate = false;
+        applyAnalyzerSettings();
+        efficientAnalogMode = false;    // Off (standard waveshapers)
+        linearPhaseEnabled = false;     // Off (minimum-phase bands)
+        showResponseCurve = true;       // Curve overlay on
+        oversamplingChoice = 0;         // Auto (Shelves factor)
+        matchedHighBands = false;       // Bilinear design
+        midSideMode = false;            // Stereo (L/R) bands
+        oversamplingQuality = 0;        // Short halfband filters
+        for (int d = 0; d < 2; ++d) {
+            dynamicEnabled[d] = false;      // Static bands
+            dynamicThresholdDb[d] = -20.0f;
+        }
+        setLinearPhasePartition(LinearPhaseEngine::DEFAULT_PARTITION_SIZE);
     }
 
     ~C1EQ() {
@@ -1246,6 +2031,70 @@ struct C1EQ : Module {
             delete spectrumAnalyzer;
             spectrumAnalyzer = nullptr;
         }
+        delete linearPhase.exchange(nullptr);
+    }
+
+    // UI thread: hand the analyzer resolution to the engine (applied by its next job)
+    void applyAnalyzerSettings() {
+        if (spectrumAnalyzer) {
+            spectrumAnalyzer->setAnalysisSettings(EqAnalysisEngine::fftSizeForIndex(analyzerFFTSize),
+                                                  analyzerWindow, analyzerOverlap);
+            const float averagingTimes[3] = {0.0f, 0.1f, 0.5f};  // Seconds
+            spectrumAnalyzer->setAveragingTime(averagingTimes[clamp(analyzerAveraging, 0, 2)]);
+            spectrumAnalyzer->setPreCapture(analyzerView != 0);  // Input FFT only when shown
+            spectrumAnalyzer->setSmoothing(analyzerSmoothing);
+            spectrumAnalyzer->setMultirate(analyzerMultirate);
+        }
+    }
+
+    // Called from the UI thread (menu, patch load); the engine is fully built before it is published
+    void setLinearPhase(bool enabled) {
+        if (enabled && !linearPhase.load(std::memory_order_relaxed)) {
+            LinearPhaseEngine* engine = new LinearPhaseEngine();
+            engine->setPartitionSize(linearPhasePartition);
+            linearPhase.store(engine, std::memory_order_release);
+        }
+        linearPhaseEnabled.store(enabled, std::memory_order_release);
+    }
+
+    void setLinearPhasePartition(int size) {
+        linearPhasePartition = size;
+        LinearPhaseEngine* engine = linearPhase.load(std::memory_order_acquire);
+        if (engine) {
+            engine->setPartitionSize(size);
+        }
+    }
+
+    // Send the band targets to the FIR designer when they changed (retried while the worker is busy)
+    // Rate-limited: moving targets (EQ-X CV, knob drags) would otherwise request a new 8191-tap
+    // design every control tick and keep the engine crossfading two FIRs on almost every block
+    void submitLinearPhaseDesign(float elapsed) {
+        linearPhaseDesignAge += elapsed;
+        if (linearPhaseSubmitted && linearPhaseDesignAge < LINEAR_PHASE_DESIGN_INTERVAL) return;
+        bool changed = !linearPhaseSubmitted;
+        for (int i = 0; i < 4 && !changed; ++i) {
+            const SVFBand::Coefficients& c = bands[i].target;
+            const SVFBand::Coefficients& sent = linearPhaseSent[i];
+            changed = c.g != sent.g || c.k != sent.k || c.m0 != sent.m0 || c.m1 != sent.m1 || c.m2 != sent.m2;
+        }
+        if (!changed) return;
+
+        LinearPhaseEngine::Section sections[4];
+        for (int i = 0; i < 4; ++i) {
+            const SVFBand::Coefficients& c = bands[i].target;
+            sections[i].g = c.g;
+            sections[i].k = c.k;
+            sections[i].m0 = c.m0;
+            sections[i].m1 = c.m1;
+            sections[i].m2 = c.m2;
+        }
+        if (activeLinearPhase->requestDesign(sections)) {
+            for (int i = 0; i < 4; ++i) {
+                linearPhaseSent[i] = bands[i].target;
+            }
+            linearPhaseSubmitted = true;
+            linearPhaseDesignAge = 0.0f;
+        }
     }
 
     void onSampleRateChange() override {
@@ -1253,26 +2102,35 @@ struct C1EQ : Module {
         if (sr <= 0.0) sr = 44100.0;  // Safe fallback
 
         // Initialize smoothers
-        for (int i = 0; i < 4; ++i) {
-            freqSmoothers[i].init(sr, 1000.0, 6.0);   // 6ms
-            qSmoothers[i].init(sr, 1.0, 25.0);        // 25ms
-            gainSmoothers[i].init(sr, 0.0, 20.0);     // 20ms
+        for (int set = 0; set < 2; ++set) {
+            for (int i = 0; i < 4; ++i) {
+                freqSmoothers[set][i].init(sr, 1000.0, 6.0);   // 6ms
+                qSmoothers[set][i].init(sr, 1.0, 25.0);        // 25ms
+                gainSmoothers[set][i].init(sr, 0.0, 20.0);     // 20ms
+            }
         }
         globalGainSmoother.init(sr, 0.0, 50.0);       // 50ms
 
-        // Shelves oversampling approach
-        oversampling_ = OversamplingFactor(sr);
-
-        // Initialize Shelves anti-aliasing filters
-        up_filter_[0].Init(sr);
-        up_filter_[1].Init(sr);
-        up_filter_[2].Init(sr);
-        down_filter_[0].Init(sr);
-        down_filter_[1].Init(sr);
+        // Initialize Shelves anti-aliasing filters and the oversampling factor
+        for (int g = 0; g < NUM_GROUPS; ++g) {
+            up_filter_[g].Init(sr);
+            down_filter_[g].Init(sr);
+        }
+        configureOversampling(sr);
 
         // Initialize analog processors
-        analogProcessorL.init(sr, SafeAnalogProcessor::TRANSPARENT);
-        analogProcessorR.init(sr, SafeAnalogProcessor::TRANSPARENT);
+        for (int g = 0; g < NUM_GROUPS; ++g) {
+            analogProcessors[g].init(sr, SafeAnalogProcessor::TRANSPARENT);
+        }
+
+        // Dynamic band detectors run at the host rate
+        hostSampleRate = sr;
+        for (int d = 0; d < 2; ++d) {
+            dynamicDetectors[d].init(sr);
+            for (int g = 0; g < NUM_GROUPS; ++g) {
+                dynamicStates[d][g].reset();
+            }
+        }
 
         // Initialize oversampler
         oversampler.init(sr);
@@ -1280,27 +2138,134 @@ struct C1EQ : Module {
         // Reset analyzer auto-shutdown state
         analyzerIdleTimer = 0.0f;
         analyzerDSPActive = true;
+        analyzerVisible = true;
+        visibilityCheckCounter = 0;
 
         // Force coefficient update on first sample after initialization
-        coefficientDivider = 15;  // Will trigger update on next process() call
+        coefficientDivider = COEFFICIENT_INTERVAL - 1;  // Will trigger update on next process() call
 
         // Reset SIMD filter states and caches
         for (int i = 0; i < 4; ++i) {
-            bands[i][0].reset();
-            bands[i][1].reset();
-            bandCache[i].f0 = -1;
-            bandCache[i].Q = -1;
-            bandCache[i].g = -1000;
-            bandCache[i].mode = -1;
+            for (int g = 0; g < NUM_GROUPS; ++g) {
+                bandStates[i][g].reset();
+            }
+            for (int set = 0; set < 2; ++set) {
+                bandCache[set][i].f0 = -1;
+                bandCache[set][i].Q = -1;
+                bandCache[set][i].g = -1000;
+                bandCache[set][i].mode = -1;
+                bandCache[set][i].sampleRate = -1;  // Jump straight to the new coefficients
+            }
         }
     }
 
-    void updateBandCoefficients(int band, double sampleRate) {
+    // Design one band's target coefficients (shared by every voice group)
+    // Glides over the update interval, jumps when the processing rate changed
+    void setBandParameters(int band, int set, SVFBand::Type type, float fc, float Q, float V, double sampleRate) {
+        bool rateChanged = std::abs(bandCache[set][band].sampleRate - sampleRate) > 1.0;
+        bool matched = matchedHighBands && band >= 2 && (type == SVFBand::PEAK || type == SVFBand::HIGHSHELF);
+        SVFBand::Coefficients c = matched ? SVFBand::designMatched(type, fc, Q, V) : SVFBand::design(type, fc, Q, V);
+        (set ? sideBands : bands)[band].setTarget(c, rateChanged ? 0 : COEFFICIENT_INTERVAL);
+        responseDirty = true;
+    }
+
+    // Audio thread: publish the band targets and master gain for the response curve
+    void publishResponse(float sampleRate, float masterGainDb) {
+        uint32_t sequence = responseSequence.load(std::memory_order_relaxed);
+        responseSequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (int i = 0; i < 4; ++i) {
+            responseSnapshot.bands[i] = bands[i].target;
+            responseSnapshot.sideBands[i] = sideBands[i].target;
+        }
+        responseSnapshot.midSide = midSideMode;
+        responseSnapshot.sampleRate = sampleRate;
+        responseSnapshot.masterGainDb = masterGainDb;
+        responseSequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    // UI thread: copy a consistent snapshot (false while the audio thread is mid-write)
+    bool readResponse(ResponseSnapshot& snapshot, uint32_t& sequence) {
+        uint32_t before = responseSequence.load(std::memory_order_acquire);
+        if (before & 1) return false;
+        snapshot = responseSnapshot;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (responseSequence.load(std::memory_order_relaxed) != before) return false;
+        sequence = before;
+        return true;
+    }
+
+    // Apply the context-menu oversampling settings (audio thread or sample rate change)
+    void configureOversampling(double sampleRate) {
+        appliedOversamplingChoice = oversamplingChoice;
+        appliedOversamplingQuality = oversamplingQuality;
+        if (oversamplingChoice == 0) {
+            oversampling_ = OversamplingFactor(sampleRate);  // Shelves approach
+        } else {
+            oversampling_ = 1 << oversamplingChoice;
+            for (int g = 0; g < NUM_GROUPS; ++g) {
+                halfband_[g].Init(oversampling_, oversamplingQuality == 1);
+            }
+        }
+        for (int g = 0; g < NUM_GROUPS; ++g) {
+            up_filter_[g].Reset();
+            down_filter_[g].Reset();
+        }
+    }
+
+    // Clear filter and analog state of a voice group that just became active
+    void resetGroup(int g, double sampleRate) {
+        for (int band = 0; band < 4; ++band) {
+            bandStates[band][g].reset();
+        }
+        for (int d = 0; d < 2; ++d) {
+            dynamicStates[d][g].reset();
+        }
+        up_filter_[g].Reset();
+        down_filter_[g].Reset();
+        halfband_[g].Reset();
+        analogProcessors[g].init(sampleRate, analogProcessors[g].currentMode);
+        if (linearPhaseRunning) {
+            activeLinearPhase->resetGroup(g);
+        }
+    }
+
+    // Run one band over a block in place (skipped while faded out, blended while fading)
+    inline void processBand(int band, int g, float_4* buffer, int size) {
+        float mix = bandMix[band];
+        if (mix <= 0.0f) return;
+        float_4 dry[MAX_OVERSAMPLING];
+        if (mix < 1.0f) {
+            for (int i = 0; i < size; ++i) {
+                dry[i] = buffer[i];
+            }
+        }
+        if (midSideMode) {
+            bands[band].processBlock(sideBands[band], bandStates[band][g], buffer, size);
+        } else {
+            bands[band].processBlock(bandStates[band][g], buffer, size);
+        }
+        if (mix >= 1.0f) return;
+        for (int i = 0; i < size; ++i) {
+            buffer[i] = dry[i] + mix * (buffer[i] - dry[i]);
+        }
+    }
+
+    // Analog stage over a block (L/R of both voices processed together)
+    inline void processAnalogBlock(int g, float_4* buffer, int size) {
+        SafeAnalogProcessor& processor = analogProcessors[g];
+        for (int i = 0; i < size; ++i) {
+            buffer[i] = processor.process(buffer[i], vcaCompressionEnabled);
+        }
+    }
+
+    // set 0 = panel bands (stereo or mid), set 1 = side bands
+    void updateBandCoefficients(int band, int set, double sampleRate) {
         if (band < 0 || band >= 4) return;
 
         // MindMeld-style parameter smoothing - use existing smoothers to prevent artifacts
         // Get correct parameter indices for each band
-        ParamIds freqParam, qParam = B2_Q_PARAM, gainParam;
+        int freqParam, qParam = B2_Q_PARAM, gainParam;
         switch(band) {
             case 0: freqParam = B1_FREQ_PARAM; gainParam = B1_GAIN_PARAM; break;
             case 1: freqParam = B2_FREQ_PARAM; qParam = B2_Q_PARAM; gainParam = B2_GAIN_PARAM; break;
@@ -1308,110 +2273,146 @@ struct C1EQ : Module {
             case 3: freqParam = B4_FREQ_PARAM; gainParam = B4_GAIN_PARAM; break;
             default: return;
         }
+        int paramOffset = set ? SIDE_PARAM_OFFSET : 0;
+        freqParam += paramOffset;
+        qParam += paramOffset;
+        gainParam += paramOffset;
+        BandCache& cache = bandCache[set][band];
 
         // Convert logarithmic frequency parameter back to Hz for processing
         double f0_raw = params[freqParam].getValue();
-        double f0 = freqSmoothers[band].process(std::pow(2.0, f0_raw));  // Convert log2 back to linear Hz
+        double f0 = freqSmoothers[set][band].process(std::exp2(f0_raw));  // Convert log2 back to linear Hz
 
         // Hardcoded Q values for Console1 hardware compatibility (bands 1 & 4 have no Q encoders)
         double Q;
         if (band == 0) {        // Band 1 (LF)
-            Q = qSmoothers[band].process(0.8);  // Hardcoded Q=0.8 for LF band
+            Q = qSmoothers[set][band].process(0.8);  // Hardcoded Q=0.8 for LF band
         } else if (band == 3) { // Band 4 (HF)
-            Q = qSmoothers[band].process(1.0);  // Hardcoded Q=1.0 for HF band
+            Q = qSmoothers[set][band].process(1.0);  // Hardcoded Q=1.0 for HF band
         } else {                // Bands 2 & 3 use parameter knobs
-            Q = qSmoothers[band].process(params[qParam].getValue());
+            Q = qSmoothers[set][band].process(params[qParam].getValue());
         }
 
-        double gain = gainSmoothers[band].process(params[gainParam].getValue());
+        double gain = gainSmoothers[set][band].process(params[gainParam].getValue());
+
+        // CV modulation from EQ-X expander (if connected)
+        // Applied after smoothing (EQ-X smooths its CVs) and clamped to the knob ranges;
+        // the SVF glide turns each new target into a per-sample coefficient ramp
+        if (rightExpander.module && rightExpander.module->model == modelC1EQCV) {
+            C1EQExpanderMessage* msg = (C1EQExpanderMessage*)(rightExpander.module->leftExpander.consumerMessage);
+            if (msg->freqCV[band] != 0.0f) {
+                ParamQuantity* freqPq = paramQuantities[freqParam];
+                double f0Oct = clamp((float)(std::log2(f0) + msg->freqCV[band]), freqPq->getMinValue(), freqPq->getMaxValue());
+                f0 = std::exp2(f0Oct);
+            }
+            gain = clamp((float)gain + msg->gainCV[band] * 20.0f, -20.0f, 20.0f);  // ±20dB range
+            if (band == 1 || band == 2) {
+                Q = clamp((float)Q + msg->qCV[band] * 11.7f, 0.3f, 12.0f);  // Full 0.3-12 range
+            }
+        }
+
+        // Dynamic bands: the detector scales the gain setting toward 0dB below threshold
+        // (gain changes at this control rate, the band glide interpolates the coefficients)
+        // The detector follows the panel band; side bands share its amount
+        // Ignored in linear-phase mode: every gain step would request a new FIR design
+        if ((band == 1 || band == 2) && dynamicEnabled[band - 1] && !linearPhaseRunning) {
+            DynamicBandDetector& detector = dynamicDetectors[band - 1];
+            if (set == 0) {
+                detector.setBand(f0, Q, hostSampleRate, COEFFICIENT_INTERVAL);
+            }
+            gain *= detector.amount(dynamicThresholdDb[band - 1]);
+        }
 
         // Band mode handling for Bands 1 & 4 (Console1 hardware design)
         int mode = 1;  // Default: bell mode for bands 2 & 3
         if (band == 0) {  // Band 1 (Low)
-            int rawMode = (int)std::round(params[B1_MODE_PARAM].getValue());
+            int rawMode = (int)std::round(params[B1_MODE_PARAM + paramOffset].getValue());
             mode = 2 - rawMode;  // Invert: 0->2(shelf), 1->1(bell), 2->0(cut)
         } else if (band == 3) {  // Band 4 (High)
-            int rawMode = (int)std::round(params[B4_MODE_PARAM].getValue());
+            int rawMode = (int)std::round(params[B4_MODE_PARAM + paramOffset].getValue());
             mode = 2 - rawMode;  // Invert: 0->2(shelf), 1->1(bell), 2->0(cut)
         }
 
         // Handle cut mode - HPF for LF band, LPF for HF band
         if (mode == 0) {  // Cut mode
+            // Parked at the edge of the audio band (the default on entering Cut mode)
+            bandNeutral[set][band] = (band == 0) ? f0 <= 20.5 : f0 >= 19500.0;
+
             // Fixed Q at 0.707 (Butterworth response), gain ignored (V=1.0)
             float fc = f0 / sampleRate;
             float cutQ = 0.707f;  // Butterworth (maximally flat passband)
             float cutV = 1.0f;     // No gain adjustment in Cut mode
 
             // Determine filter type based on band
-            dsp::TBiquadFilter<float_4>::Type cutFilterType;
+            SVFBand::Type cutFilterType;
             if (band == 0) {  // LF band = High-pass (removes low frequencies)
-                cutFilterType = dsp::TBiquadFilter<float_4>::HIGHPASS;
+                cutFilterType = SVFBand::HIGHPASS;
             } else if (band == 3) {  // HF band = Low-pass (removes high frequencies)
-                cutFilterType = dsp::TBiquadFilter<float_4>::LOWPASS;
+                cutFilterType = SVFBand::LOWPASS;
             } else {
                 // Bands 2 & 3 (mid bands) don't have Cut mode - this shouldn't happen
                 // Bypass if somehow triggered
-                bands[band][0].setParameters(dsp::TBiquadFilter<float_4>::PEAK, 0.25f, 1.0f, 1.0f);
-                bands[band][1].setParameters(dsp::TBiquadFilter<float_4>::PEAK, 0.25f, 1.0f, 1.0f);
+                setBandParameters(band, set, SVFBand::PEAK, 0.25f, 1.0f, 1.0f, sampleRate);
                 return;
             }
 
             // Configure Cut mode filters with caching
-            if (std::abs(bandCache[band].f0 - f0) > 1e-6 ||
-                std::abs(bandCache[band].Q - cutQ) > 1e-4 ||
-                bandCache[band].mode != mode ||
-                std::abs(bandCache[band].sampleRate - sampleRate) > 1.0) {
-
-                bands[band][0].setParameters(cutFilterType, fc, cutQ, cutV);
-                bands[band][1].setParameters(cutFilterType, fc, cutQ, cutV);
-
-                bandCache[band].f0 = f0;
-                bandCache[band].Q = cutQ;
-                bandCache[band].g = 0.0;  // Gain not used in Cut mode
-                bandCache[band].mode = mode;
-                bandCache[band].sampleRate = sampleRate;
+            if (std::abs(cache.f0 - f0) > 1e-6 ||
+                std::abs(cache.Q - cutQ) > 1e-4 ||
+                cache.mode != mode ||
+                std::abs(cache.sampleRate - sampleRate) > 1.0) {
+
+                setBandParameters(band, set, cutFilterType, fc, cutQ, cutV, sampleRate);
+
+                cache.f0 = f0;
+                cache.Q = cutQ;
+                cache.g = 0.0;  // Gain not used in Cut mode
+                cache.mode = mode;
+                cache.sampleRate = sampleRate;
             }
             return;
         }
 
+        // Bell and shelf are an exact identity at 0dB
+        bandNeutral[set][band] = std::abs(gain) < 0.01;
+
         // Proportional Q behavior (from four-band example) - now optional
         double Qeff = enableProportionalQ ? Q * (1.0 + 0.02 * std::abs(gain)) : Q;
 
         // Check cache and redesign if needed (including mode changes and sample rate)
         const double EPS_F = 1e-6;
-        if (std::abs(bandCache[band].f0 - f0) > EPS_F ||
-            std::abs(bandCache[band].Q - Qeff) > 1e-4 ||
-            std::abs(bandCache[band].g - gain) > 1e-4 ||
-            bandCache[band].mode != mode ||
-            std::abs(bandCache[band].sampleRate - sampleRate) > 1.0) {  // Sample rate changed (oversampling toggle)
+        if (std::abs(cache.f0 - f0) > EPS_F ||
+            std::abs(cache.Q - Qeff) > 1e-4 ||
+            std::abs(cache.g - gain) > 1e-4 ||
+            cache.mode != mode ||
+            std::abs(cache.sampleRate - sampleRate) > 1.0) {  // Sample rate changed (oversampling toggle)
 
             // SIMD filter setup: normalized frequency and V parameter
             float fc = f0 / sampleRate;
             float V = std::pow(10.0f, gain / 40.0f);
 
             // Configure filter type based on mode
-            dsp::TBiquadFilter<float_4>::Type filterType;
+            SVFBand::Type filterType;
             if (mode == 1) {  // Bell mode (peaking)
-                filterType = dsp::TBiquadFilter<float_4>::PEAK;
+                filterType = SVFBand::PEAK;
             } else if (mode == 2) {  // Shelf mode
                 if (band == 0) {  // Band 1 = Low shelf
-                    filterType = dsp::TBiquadFilter<float_4>::LOWSHELF;
+                    filterType = SVFBand::LOWSHELF;
                 } else {  // Band 4 = High shelf
-                    filterType = dsp::TBiquadFilter<float_4>::HIGHSHELF;
+                    filterType = SVFBand::HIGHSHELF;
                 }
             } else {
-                filterType = dsp::TBiquadFilter<float_4>::PEAK;  // Fallback
+                filterType = SVFBand::PEAK;  // Fallback
             }
 
-            // Configure stereo SIMD filters with mode support
-            bands[band][0].setParameters(filterType, fc, Qeff, V);
-            bands[band][1].setParameters(filterType, fc, Qeff, V);
+            // Configure SIMD filters with mode support (coefficients shared by all lanes and groups)
+            setBandParameters(band, set, filterType, fc, Qeff, V, sampleRate);
 
-            bandCache[band].f0 = f0;
-            bandCache[band].Q = Qeff;
-            bandCache[band].g = gain;
-            bandCache[band].mode = mode;
-            bandCache[band].sampleRate = sampleRate;  // Cache sample rate
+            cache.f0 = f0;
+            cache.Q = Qeff;
+            cache.g = gain;
+            cache.mode = mode;
+            cache.sampleRate = sampleRate;  // Cache sample rate
         }
     }
 
@@ -1425,8 +2426,43 @@ struct C1EQ : Module {
         SafeAnalogProcessor::AnalogMode analogMode =
             (SafeAnalogProcessor::AnalogMode)rack::math::clamp(analogModeInt, 0, 3);
 
-        analogProcessorL.setMode(analogMode);
-        analogProcessorR.setMode(analogMode);
+        if (oversamplingChoice != appliedOversamplingChoice || oversamplingQuality != appliedOversamplingQuality) {
+            configureOversampling(args.sampleRate);
+        }
+
+        // Linear-phase mode replaces the band filters and runs at the host rate
+        // (flag first: its acquire makes the engine published before it visible)
+        bool linearPhaseOn = linearPhaseEnabled.load(std::memory_order_acquire);
+        activeLinearPhase = linearPhase.load(std::memory_order_acquire);
+        bool linearPhaseActive = linearPhaseOn && activeLinearPhase && !bypassed;
+        bool oversamplingEnabled = params[OVERSAMPLE_PARAM].getValue() > 0.5f && !linearPhaseActive;
+        if (linearPhaseActive && !linearPhaseRunning) {
+            activeLinearPhase->reset();
+            linearPhaseSubmitted = false;
+            for (int i = 0; i < ANALYZER_DELAY_SIZE; ++i) {
+                analyzerInputDelay[0][i] = 0.0f;
+                analyzerInputDelay[1][i] = 0.0f;
+            }
+            coefficientDivider = COEFFICIENT_INTERVAL - 1;  // Design right away
+        }
+        linearPhaseRunning = linearPhaseActive;
+
+        // Polyphonic stereo inputs: the wider of L/R sets the voice count
+        int channels = std::max(1, std::max(inputs[AUDIO_INPUT_L].getChannels(),
+                                            inputs[AUDIO_INPUT_R].getChannels()));
+        int groups = (channels + 1) / 2;
+
+        if (groups > activeGroups) {
+            for (int g = activeGroups; g < groups; ++g) {
+                resetGroup(g, args.sampleRate);
+            }
+        }
+        activeGroups = groups;
+
+        for (int g = 0; g < groups; ++g) {
+            analogProcessors[g].setMode(analogMode);
+            analogProcessors[g].setADAA(efficientAnalogMode);
+        }
 
         // Mode values needed outside light divider for Cut mode logic
         float b1ModeValue = params[B1_MODE_PARAM].getValue();
@@ -1464,7 +2500,7 @@ struct C1EQ : Module {
             }
 
             // Oversampling indicator light
-            lights[OVERSAMPLE_LIGHT].setBrightness(params[OVERSAMPLE_PARAM].getValue() > 0.5f ? 1.0f : 0.0f);
+            lights[OVERSAMPLE_LIGHT].setBrightness(oversamplingEnabled ? 1.0f : 0.0f);
 
             // LF mode lights (3 positions: high-pass, bell, shelf)
             lights[B1_MODE_LIGHT + 0].setBrightness(b1ModeValue == 2.0f ? 0.7f : 0.0f); // High-pass (top)
@@ -1477,9 +2513,10 @@ struct C1EQ : Module {
             lights[B4_MODE_LIGHT + 2].setBrightness(b4ModeValue == 0.0f ? 0.7f : 0.0f); // Shelf (bottom)
 
             // Clipping indicator (Shelves-inspired RGB display)
-            double clipLevelL = analogProcessorL.getClippingLevel();
-            double clipLevelR = analogProcessorR.getClippingLevel();
-            double maxClipLevel = std::max(clipLevelL, clipLevelR);
+            float maxClipLevel = 0.0f;
+            for (int g = 0; g < groups; ++g) {
+                maxClipLevel = std::max(maxClipLevel, analogProcessors[g].getClippingLevel());
+            }
 
             // RGB clipping indicator: green->amber->red progression with optimized brightness
             if (maxClipLevel < 0.1) {
@@ -1533,100 +2570,231 @@ struct C1EQ : Module {
             params[B4_GAIN_PARAM].setValue(0.0f);
         }
 
-        // Get stereo inputs
-        float inputL = inputs[AUDIO_INPUT_L].getVoltage();
-        float inputR = inputs[AUDIO_INPUT_R].isConnected() ?
-                      inputs[AUDIO_INPUT_R].getVoltage() : inputL;  // Mono fallback
+        // Interleave voices into float_4 groups (mono fallback per voice)
+        bool rightConnected = inputs[AUDIO_INPUT_R].isConnected();
+        float_4 in[NUM_GROUPS];
+        for (int g = 0; g < groups; ++g) {
+            for (int v = 0; v < 2; ++v) {
+                int c = 2 * g + v;
+                float inL = 0.0f, inR = 0.0f;
+                if (c < channels) {
+                    inL = inputs[AUDIO_INPUT_L].getPolyVoltage(c);
+                    inR = rightConnected ? inputs[AUDIO_INPUT_R].getPolyVoltage(c) : inL;
+                }
+                in[g][2 * v] = inL;
+                in[g][2 * v + 1] = inR;
+            }
+        }
 
-        float outputL = inputL;
-        float outputR = inputR;
+        float_4 out[NUM_GROUPS];
+        for (int g = 0; g < groups; ++g) {
+            out[g] = in[g];
+        }
 
         if (!bypassed) {
-            // Check if oversampling is enabled (moved up to calculate correct rate)
-            bool oversamplingEnabled = params[OVERSAMPLE_PARAM].getValue() > 0.5f;
+            // Switching the B3/B4 design method redesigns those bands (with the usual glide)
+            if (matchedHighBands != appliedMatchedHighBands) {
+                appliedMatchedHighBands = matchedHighBands;
+                for (int set = 0; set < 2; ++set) {
+                    bandCache[set][2].mode = -1;
+                    bandCache[set][3].mode = -1;
+                }
+            }
+
+            // Entering M/S: side bands jump to their settings, filter state starts clean
+            if (midSideMode != appliedMidSideMode) {
+                appliedMidSideMode = midSideMode;
+                for (int i = 0; i < 4; ++i) {
+                    bandCache[1][i].sampleRate = -1;
+                    for (int g = 0; g < NUM_GROUPS; ++g) {
+                        bandStates[i][g].reset();
+                    }
+                }
+                responseDirty = true;
+            }
 
             // Update coefficients at reduced rate (every 16 samples for efficiency)
             double baseSampleRate = args.sampleRate;
             double effectiveSampleRate = oversamplingEnabled ? (baseSampleRate * oversampling_) : baseSampleRate;
-            if (++coefficientDivider >= 16) {
+            if (++coefficientDivider >= COEFFICIENT_INTERVAL) {
                 coefficientDivider = 0;
                 for (int i = 0; i < 4; ++i) {
-                    updateBandCoefficients(i, effectiveSampleRate);
+                    updateBandCoefficients(i, 0, effectiveSampleRate);
+                    if (midSideMode) {
+                        updateBandCoefficients(i, 1, effectiveSampleRate);
+                    }
+                }
+                if (linearPhaseActive) {
+                    submitLinearPhaseDesign(COEFFICIENT_INTERVAL * args.sampleTime);
+                }
+
+                float masterGainTargetDb = params[GLOBAL_GAIN_PARAM].getValue();
+                if (responseDirty || masterGainTargetDb != responseSnapshot.masterGainDb) {
+                    publishResponse(effectiveSampleRate, masterGainTargetDb);
+                    responseDirty = false;
                 }
             }
 
-            // Master gain with smoothing for click-free operation
-            double masterGainDB = globalGainSmoother.process(params[GLOBAL_GAIN_PARAM].getValue());
-            double masterGain = std::pow(10.0, masterGainDB / 20.0);
+            // Per-sample coefficient glide (shared by all groups and sub-samples)
+            for (int i = 0; i < 4; ++i) {
+                bands[i].tick();
+                if (midSideMode) {
+                    sideBands[i].tick();
+                }
+            }
 
-            if (oversamplingEnabled) {
-                // Shelves true oversampling implementation (copied exact structure)
-                float processedL = 0.0f, processedR = 0.0f;
+            // Sparse execution: fade neutral bands out once their glide has settled,
+            // fade active ones back in from cleared state (in M/S both sets must be neutral)
+            for (int i = 0; i < 4; ++i) {
+                bool neutral = bandNeutral[0][i] && bands[i].rampRemaining == 0;
+                if (midSideMode) {
+                    neutral = neutral && bandNeutral[1][i] && sideBands[i].rampRemaining == 0;
+                }
+                float mixTarget = neutral ? 0.0f : 1.0f;
+                if (bandMix[i] == mixTarget) continue;
+                if (bandMix[i] <= 0.0f) {
+                    for (int g = 0; g < NUM_GROUPS; ++g) {
+                        bandStates[i][g].reset();
+                    }
+                }
+                float fadeStep = 1.0f / BAND_FADE_SAMPLES;
+                bandMix[i] = clamp(bandMix[i] + (mixTarget > bandMix[i] ? fadeStep : -fadeStep), 0.0f, 1.0f);
+            }
 
-                for (int i = 0; i < oversampling_; i++) {
-                    // Zero-stuffing upsampling with anti-aliasing filters (Shelves pattern)
-                    float upsampledL = up_filter_[0].Process((i == 0) ? (inputL * oversampling_) : 0.0f);
-                    float upsampledR = up_filter_[1].Process((i == 0) ? (inputR * oversampling_) : 0.0f);
+            // Dynamic band detectors on the input (stereo and all voices linked by peak)
+            for (int d = 0; d < 2 && !linearPhaseActive; ++d) {
+                if (!dynamicEnabled[d]) continue;
+                DynamicBandDetector& detector = dynamicDetectors[d];
+                detector.filter.tick();
+                float_4 peak = float_4::zero();
+                for (int g = 0; g < groups; ++g) {
+                    float_4 x = in[g];
+                    detector.filter.processBlock(dynamicStates[d][g], &x, 1);
+                    peak = simd::fmax(peak, simd::fabs(x));
+                }
+                detector.update(std::max(std::max(peak[0], peak[1]), std::max(peak[2], peak[3])));
+            }
+
+            // Master gain with smoothing for click-free operation
+            double masterGainDB = globalGainSmoother.process(params[GLOBAL_GAIN_PARAM].getValue());
+            float masterGain = std::pow(10.0, masterGainDB / 20.0);
+
+            for (int g = 0; g < groups; ++g) {
+                float_4 y;
+
+                if (linearPhaseActive) {
+                    // Linear-phase path: analog stage, then the partitioned FIR (delayed output)
+                    y = analogProcessors[g].process(in[g], vcaCompressionEnabled);
+                    y = activeLinearPhase->process(g, y);
+                    y *= masterGain;
+
+                } else if (oversamplingEnabled) {
+                    // Shelves true oversampling, processed stage by stage over the
+                    // block of oversampled sub-samples belonging to this host sample
+                    float_4 block[MAX_OVERSAMPLING];
+                    int blockSize = (oversampling_ < MAX_OVERSAMPLING) ? oversampling_ : MAX_OVERSAMPLING;
+
+                    bool halfband = appliedOversamplingChoice > 0;
+                    if (halfband) {
+                        halfband_[g].Upsample(in[g], block);
+                    } else {
+                        // Zero-stuffing upsampling with anti-aliasing filters (Shelves pattern)
+                        block[0] = in[g] * (float)oversampling_;
+                        for (int i = 1; i < blockSize; i++) {
+                            block[i] = float_4::zero();
+                        }
+                        up_filter_[g].ProcessBlock(block, blockSize);
+                    }
 
                     // Core processing chain at higher sample rate
-                    float yL = analogProcessorL.process(upsampledL, vcaCompressionEnabled);
-                    float yR = analogProcessorR.process(upsampledR, vcaCompressionEnabled);
+                    processAnalogBlock(g, block, blockSize);
 
-                    // EQ processing
+                    // EQ processing (two stereo voices per SIMD vector)
+                    if (midSideMode) {
+                        for (int i = 0; i < blockSize; i++) {
+                            block[i] = midSideEncode(block[i]);
+                        }
+                    }
                     for (int band = 0; band < 4; ++band) {
-                        float_4 sigL = float_4(yL, 0.0f, 0.0f, 0.0f);
-                        float_4 sigR = float_4(yR, 0.0f, 0.0f, 0.0f);
-                        sigL = bands[band][0].process(sigL);
-                        sigR = bands[band][1].process(sigR);
-                        yL = sigL[0];
-                        yR = sigR[0];
+                        processBand(band, g, block, blockSize);
+                    }
+                    if (midSideMode) {
+                        for (int i = 0; i < blockSize; i++) {
+                            block[i] = midSideDecode(block[i]);
+                        }
                     }
 
                     // Clamping before downsampling (Shelves pattern)
-                    yL = simd::clamp(yL, -10.5f, 10.5f);
-                    yR = simd::clamp(yR, -10.5f, 10.5f);
+                    for (int i = 0; i < blockSize; i++) {
+                        block[i] = simd::clamp(block[i], -10.5f, 10.5f);
+                    }
 
-                    // Downsampling with anti-aliasing filters (Shelves pattern)
-                    processedL = down_filter_[0].Process(yL);
-                    processedR = down_filter_[1].Process(yR);
-                }
+                    if (halfband) {
+                        y = halfband_[g].Downsample(block) * masterGain;
+                    } else {
+                        // Downsampling with anti-aliasing filters (Shelves pattern)
+                        down_filter_[g].ProcessBlock(block, blockSize);
+                        y = block[blockSize - 1] * masterGain;
+                    }
 
-                outputL = processedL * masterGain;
-                outputR = processedR * masterGain;
+                } else {
+                    // Standard processing without oversampling
+                    // Stage 1: Analog input processing
+                    y = analogProcessors[g].process(in[g], vcaCompressionEnabled);
 
-            } else {
-                // Standard processing without oversampling
-                double yL = inputL, yR = inputR;
-
-                // Stage 1: Analog input processing
-                yL = analogProcessorL.process(yL, vcaCompressionEnabled);
-                yR = analogProcessorR.process(yR, vcaCompressionEnabled);
-
-                // Stage 2: EQ processing chain
-                for (int band = 0; band < 4; ++band) {
-                    // Pack into SIMD for L channel
-                    float_4 signalL = float_4(yL, 0.0f, 0.0f, 0.0f);
-                    signalL = bands[band][0].process(signalL);
-                    yL = signalL[0];
-
-                    // Pack into SIMD for R channel
-                    float_4 signalR = float_4(yR, 0.0f, 0.0f, 0.0f);
-                    signalR = bands[band][1].process(signalR);
-                    yR = signalR[0];
+                    // Stage 2: EQ processing chain (two stereo voices per SIMD vector)
+                    if (midSideMode) {
+                        y = midSideEncode(y);
+                    }
+                    for (int band = 0; band < 4; ++band) {
+                        processBand(band, g, &y, 1);
+                    }
+                    if (midSideMode) {
+                        y = midSideDecode(y);
+                    }
+
+                    // Stage 3: Output gain
+                    y *= masterGain;
                 }
 
-                // Stage 3: Output gain
-                outputL = yL * masterGain;
-                outputR = yR * masterGain;
+                // Final clipping detection (post-EQ, post-master gain)
+                analogProcessors[g].updateClippingDetector(y);
+
+                // Final output clamping (VCV Rack compliance)
+                out[g] = simd::clamp(y, -10.5f, 10.5f);
             }
 
-            // Final clipping detection (post-EQ, post-master gain)
-            analogProcessorL.updateClippingDetector(outputL);
-            analogProcessorR.updateClippingDetector(outputR);
+            if (linearPhaseActive) {
+                activeLinearPhase->advance(groups);
+            }
+        }
 
-            // Final output clamping (VCV Rack compliance)
-            outputL = simd::clamp(outputL, -10.5f, 10.5f);
-            outputR = simd::clamp(outputR, -10.5f, 10.5f);
+        // Analyzer source: sum of all voices or one selected voice (EQ input too for the
+        // input/difference views)
+        float outputL = 0.0f, outputR = 0.0f;
+        float inputL = 0.0f, inputR = 0.0f;
+        if (analyzerSource == 0) {
+            for (int c = 0; c < channels; ++c) {
+                outputL += out[c / 2][2 * (c % 2)];
+                outputR += out[c / 2][2 * (c % 2) + 1];
+                inputL += in[c / 2][2 * (c % 2)];
+                inputR += in[c / 2][2 * (c % 2) + 1];
+            }
+        } else {
+            int c = std::min(analyzerSource - 1, channels - 1);
+            outputL = out[c / 2][2 * (c % 2)];
+            outputR = out[c / 2][2 * (c % 2) + 1];
+            inputL = in[c / 2][2 * (c % 2)];
+            inputR = in[c / 2][2 * (c % 2) + 1];
+        }
+        if (linearPhaseActive) {
+            // Align the input with the FIR output it is compared against
+            analyzerInputDelay[0][analyzerDelayPos] = inputL;
+            analyzerInputDelay[1][analyzerDelayPos] = inputR;
+            int readPos = (analyzerDelayPos - activeLinearPhase->getActiveLatency()) & (ANALYZER_DELAY_SIZE - 1);
+            inputL = analyzerInputDelay[0][readPos];
+            inputR = analyzerInputDelay[1][readPos];
+            analyzerDelayPos = (analyzerDelayPos + 1) & (ANALYZER_DELAY_SIZE - 1);
         }
 
         // Feed signals to spectrum analyzer with auto-shutdown after 8 seconds of inactivity
@@ -1634,15 +2802,28 @@ struct C1EQ : Module {
         if (!isShuttingDown.load() && spectrumAnalyzer) {
             bool analyserOn = params[ANALYSER_ENABLE_PARAM].getValue() > 0.5f;
 
-            if (analyserOn) {
+            if (++visibilityCheckCounter >= VISIBILITY_CHECK_INTERVAL) {
+                visibilityCheckCounter = 0;
+                double drawTime = analyzerDrawTime.load(std::memory_order_relaxed);
+                analyzerVisible = system::getTime() - drawTime < ANALYZER_VISIBLE_TIMEOUT;
+            }
+
+            if (!analyzerVisible) {
+                // Nothing on screen to show the result - no samples, no jobs
+                // (resumes within one poll interval of the next draw)
+                if (analyzerDSPActive) {
+                    spectrumAnalyzer->stopAnalysis();
+                    analyzerDSPActive = false;
+                }
+            } else if (analyserOn) {
                 // Display is ON - ensure DSP active and reset timer
                 if (!analyzerDSPActive) {
-                    spectrumAnalyzer->startWorkerThread();
+                    spectrumAnalyzer->startAnalysis();
                     analyzerDSPActive = true;
                 }
                 analyzerIdleTimer = 0.0f;
                 spectrumAnalyzer->setSampleRate(args.sampleRate);
-                spectrumAnalyzer->addSample(outputL, outputR);
+                spectrumAnalyzer->addSample(outputL, outputR, inputL, inputR);
             } else {
                 // Display is OFF
                 if (analyzerDSPActive) {
@@ -1653,9 +2834,9 @@ struct C1EQ : Module {
                     // Increment idle timer
                     analyzerIdleTimer += args.sampleTime;
 
-                    // After 8 seconds, shut down worker thread
+                    // After 8 seconds, stop scheduling analysis jobs
                     if (analyzerIdleTimer >= 8.0f) {
-                        spectrumAnalyzer->stopWorkerThread();
+                        spectrumAnalyzer->stopAnalysis();
                         analyzerDSPActive = false;
                     }
                 }
@@ -1664,14 +2845,38 @@ struct C1EQ : Module {
         }
 
         // Set outputs
-        outputs[AUDIO_OUTPUT_L].setVoltage(outputL);
-        outputs[AUDIO_OUTPUT_R].setVoltage(outputR);
+        outputs[AUDIO_OUTPUT_L].setChannels(channels);
+        outputs[AUDIO_OUTPUT_R].setChannels(channels);
+        for (int c = 0; c < channels; ++c) {
+            outputs[AUDIO_OUTPUT_L].setVoltage(out[c / 2][2 * (c % 2)], c);
+            outputs[AUDIO_OUTPUT_R].setVoltage(out[c / 2][2 * (c % 2) + 1], c);
+        }
     }
 
     json_t* dataToJson() override {
         json_t* root_j = json_object();
         json_object_set_new(root_j, "vcaCompressionEnabled", json_boolean(vcaCompressionEnabled));
         json_object_set_new(root_j, "enableProportionalQ", json_boolean(enableProportionalQ));
+        json_object_set_new(root_j, "analyzerSource", json_integer(analyzerSource));
+        json_object_set_new(root_j, "analyzerFFTSize", json_integer(EqAnalysisEngine::fftSizeForIndex(analyzerFFTSize)));
+        json_object_set_new(root_j, "analyzerWindow", json_integer(analyzerWindow));
+        json_object_set_new(root_j, "analyzerOverlap", json_integer(analyzerOverlap));
+        json_object_set_new(root_j, "analyzerAveraging", json_integer(analyzerAveraging));
+        json_object_set_new(root_j, "analyzerView", json_integer(analyzerView));
+        json_object_set_new(root_j, "analyzerSmoothing", json_integer(analyzerSmoothing));
+        json_object_set_new(root_j, "analyzerMultirate", json_boolean(analyzerMultirate));
+        json_object_set_new(root_j, "efficientAnalogMode", json_boolean(efficientAnalogMode));
+        json_object_set_new(root_j, "linearPhase", json_boolean(linearPhaseEnabled.load()));
+        json_object_set_new(root_j, "linearPhasePartition", json_integer(linearPhasePartition));
+        json_object_set_new(root_j, "showResponseCurve", json_boolean(showResponseCurve));
+        json_object_set_new(root_j, "matchedHighBands", json_boolean(matchedHighBands));
+        json_object_set_new(root_j, "midSideMode", json_boolean(midSideMode));
+        json_object_set_new(root_j, "oversamplingFactor", json_integer(oversamplingChoice));
+        json_object_set_new(root_j, "oversamplingQuality", json_integer(oversamplingQuality));
+        json_object_set_new(root_j, "lmfDynamic", json_boolean(dynamicEnabled[0]));
+        json_object_set_new(root_j, "lmfDynamicThreshold", json_real(dynamicThresholdDb[0]));
+        json_object_set_new(root_j, "hmfDynamic", json_boolean(dynamicEnabled[1]));
+        json_object_set_new(root_j, "hmfDynamicThreshold", json_real(dynamicThresholdDb[1]));
         return root_j;
     }
 
@@ -1683,6 +2888,89 @@ struct C1EQ : Module {
         json_t* enableProportionalQJ = json_object_get(root_j, "enableProportionalQ");
         if (enableProportionalQJ)
             enableProportionalQ = json_boolean_value(enableProportionalQJ);
+
+        json_t* analyzerSourceJ = json_object_get(root_j, "analyzerSource");
+        if (analyzerSourceJ)
+            analyzerSource = clamp((int)json_integer_value(analyzerSourceJ), 0, MAX_CHANNELS);
+
+        json_t* analyzerFFTSizeJ = json_object_get(root_j, "analyzerFFTSize");
+        if (analyzerFFTSizeJ) {
+            int size = (int)json_integer_value(analyzerFFTSizeJ);
+            analyzerFFTSize = 0;
+            while (analyzerFFTSize < EqAnalysisEngine::NUM_FFT_SIZES - 1 &&
+                   EqAnalysisEngine::fftSizeForIndex(analyzerFFTSize) < size) {
+                analyzerFFTSize++;
+            }
+        }
+
+        json_t* analyzerWindowJ = json_object_get(root_j, "analyzerWindow");
+        if (analyzerWindowJ)
+            analyzerWindow = clamp((int)json_integer_value(analyzerWindowJ), 0, EqAnalysisEngine::NUM_WINDOWS - 1);
+
+        json_t* analyzerOverlapJ = json_object_get(root_j, "analyzerOverlap");
+        if (analyzerOverlapJ)
+            analyzerOverlap = clamp((int)json_integer_value(analyzerOverlapJ), 0, EqAnalysisEngine::NUM_OVERLAPS - 1);
+
+        json_t* analyzerAveragingJ = json_object_get(root_j, "analyzerAveraging");
+        if (analyzerAveragingJ)
+            analyzerAveraging = clamp((int)json_integer_value(analyzerAveragingJ), 0, 2);
+
+        json_t* analyzerViewJ = json_object_get(root_j, "analyzerView");
+        if (analyzerViewJ)
+            analyzerView = clamp((int)json_integer_value(analyzerViewJ), 0, 2);
+
+        json_t* analyzerSmoothingJ = json_object_get(root_j, "analyzerSmoothing");
+        if (analyzerSmoothingJ)
+            analyzerSmoothing = clamp((int)json_integer_value(analyzerSmoothingJ), 0, EqAnalysisEngine::NUM_SMOOTHINGS - 1);
+
+        json_t* analyzerMultirateJ = json_object_get(root_j, "analyzerMultirate");
+        if (analyzerMultirateJ)
+            analyzerMultirate = json_boolean_value(analyzerMultirateJ);
+        applyAnalyzerSettings();
+
+        json_t* efficientAnalogModeJ = json_object_get(root_j, "efficientAnalogMode");
+        if (efficientAnalogModeJ)
+            efficientAnalogMode = json_boolean_value(efficientAnalogModeJ);
+
+        json_t* linearPhasePartitionJ = json_object_get(root_j, "linearPhasePartition");
+        if (linearPhasePartitionJ)
+            setLinearPhasePartition(clamp((int)json_integer_value(linearPhasePartitionJ),
+                                          LinearPhaseEngine::MIN_PARTITION_SIZE, LinearPhaseEngine::MAX_PARTITION_SIZE));
+
+        json_t* linearPhaseJ = json_object_get(root_j, "linearPhase");
+        if (linearPhaseJ)
+            setLinearPhase(json_boolean_value(linearPhaseJ));
+
+        json_t* showResponseCurveJ = json_object_get(root_j, "showResponseCurve");
+        if (showResponseCurveJ)
+            showResponseCurve = json_boolean_value(showResponseCurveJ);
+
+        json_t* matchedHighBandsJ = json_object_get(root_j, "matchedHighBands");
+        if (matchedHighBandsJ)
+            matchedHighBands = json_boolean_value(matchedHighBandsJ);
+
+        json_t* midSideModeJ = json_object_get(root_j, "midSideMode");
+        if (midSideModeJ)
+            midSideMode = json_boolean_value(midSideModeJ);
+
+        json_t* oversamplingFactorJ = json_object_get(root_j, "oversamplingFactor");
+        if (oversamplingFactorJ)
+            oversamplingChoice = clamp((int)json_integer_value(oversamplingFactorJ), 0, 3);
+
+        json_t* oversamplingQualityJ = json_object_get(root_j, "oversamplingQuality");
+        if (oversamplingQualityJ)
+            oversamplingQuality = clamp((int)json_integer_value(oversamplingQualityJ), 0, 1);
+
+        const char* dynamicKeys[2][2] = {{"lmfDynamic", "lmfDynamicThreshold"},
+                                         {"hmfDynamic", "hmfDynamicThreshold"}};
+        for (int d = 0; d < 2; ++d) {
+            json_t* dynamicJ = json_object_get(root_j, dynamicKeys[d][0]);
+            if (dynamicJ)
+                dynamicEnabled[d] = json_boolean_value(dynamicJ);
+            json_t* thresholdJ = json_object_get(root_j, dynamicKeys[d][1]);
+            if (thresholdJ)
+                dynamicThresholdDb[d] = clamp((float)json_number_value(thresholdJ), -60.0f, 0.0f);
+        }
     }
 };
 
@@ -1702,6 +2990,46 @@ struct SpectrumDisplayWidget : LedDisplay {
     Module* module = nullptr;
     EqAnalysisEngine* engine = nullptr;
 
+    // EQ response at the analyzer's band centres (dB), recomputed only for new snapshots
+    static constexpr float CURVE_RANGE_DB = 24.0f;  // Top/bottom edge of the display
+    static constexpr float MIN_VISIBLE_ZOOM = 0.3f;  // Below this the display is too small to read
+    float curveDb[EqAnalysisEngine::DISPLAY_BANDS] = {};
+    float sideCurveDb[EqAnalysisEngine::DISPLAY_BANDS] = {};  // M/S mode: side bands
+    uint32_t curveSequence = 0;  // 0 = nothing published yet
+    C1EQ::ResponseSnapshot curveSnapshot;
+
+    void step() override {
+        LedDisplay::step();
+        if (engine) {
+            engine->updateDisplay(system::getTime());  // Peak hold/decay timed per UI frame
+        }
+        C1EQ* eq = static_cast<C1EQ*>(module);
+        if (!eq || !eq->showResponseCurve) return;
+
+        uint32_t sequence;
+        if (eq->responseSequence.load(std::memory_order_acquire) == curveSequence) return;
+        if (!eq->readResponse(curveSnapshot, sequence)) return;  // Retry next frame
+        curveSequence = sequence;
+
+        const int bands = EqAnalysisEngine::DISPLAY_BANDS;
+        for (int i = 0; i < bands; i++) {
+            float logFreq = EqAnalysisEngine::MIN_LOG_FREQ +
+                (EqAnalysisEngine::MAX_LOG_FREQ - EqAnalysisEngine::MIN_LOG_FREQ) * i / (float)(bands - 1);
+            double fc = std::min(std::pow(10.0, (double)logFreq) / curveSnapshot.sampleRate, 0.4999);
+            double w = std::tan(M_PI * fc);
+            double magnitude = 1.0;
+            double sideMagnitude = 1.0;
+            for (int b = 0; b < 4; b++) {
+                magnitude *= SVFBand::magnitude(curveSnapshot.bands[b], w);
+                if (curveSnapshot.midSide) {
+                    sideMagnitude *= SVFBand::magnitude(curveSnapshot.sideBands[b], w);
+                }
+            }
+            curveDb[i] = 20.0f * std::log10(std::max(magnitude, 1e-6)) + curveSnapshot.masterGainDb;
+            sideCurveDb[i] = 20.0f * std::log10(std::max(sideMagnitude, 1e-6)) + curveSnapshot.masterGainDb;
+        }
+    }
+
     void drawBackground(const DrawArgs& args) {
         // Inner box with grey thin line and minimal rounded corners
         nvgBeginPath(args.vg);
@@ -1778,9 +3106,88 @@ struct SpectrumDisplayWidget : LedDisplay {
         }
     }
 
+    void drawResponseCurve(const DrawArgs& args) {
+        C1EQ* eq = static_cast<C1EQ*>(module);
+        if (!eq || !eq->showResponseCurve || curveSequence == 0) return;
+
+        bool bypassed = eq->params[C1EQ::BYPASS_PARAM].getValue() > 0.5f;
+        int alpha = bypassed ? 60 : 200;  // Dimmed while bypassed
+        if (curveSnapshot.midSide) {
+            strokeCurve(args, sideCurveDb, nvgRGBA(150, 200, 255, alpha));  // Side under mid
+        }
+        strokeCurve(args, curveDb, nvgRGBA(255, 230, 180, alpha));
+    }
+
+    void strokeCurve(const DrawArgs& args, const float* db, NVGcolor color) {
+        float innerX = 2.0f;
+        float innerY = 2.0f;
+        float innerWidth = box.size.x - 4.0f;
+        float innerHeight = box.size.y - 4.0f;
+        float barWidth = innerWidth / (float)EqAnalysisEngine::DISPLAY_BANDS;
+        float centerY = innerY + innerHeight * 0.5f;
+        float dbScale = (innerHeight * 0.5f - 1.0f) / CURVE_RANGE_DB;
+
+        nvgBeginPath(args.vg);
+        for (int i = 0; i < EqAnalysisEngine::DISPLAY_BANDS; i++) {
+            float x = innerX + (i + 0.5f) * barWidth;
+            float y = centerY - clamp(db[i], -CURVE_RANGE_DB, CURVE_RANGE_DB) * dbScale;
+            if (i == 0) {
+                nvgMoveTo(args.vg, x, y);
+            } else {
+                nvgLineTo(args.vg, x, y);
+            }
+        }
+        nvgStrokeColor(args.vg, color);
+        nvgStrokeWidth(args.vg, 1.2f);
+        nvgStroke(args.vg);
+    }
+
+    // Input + Output view: EQ input as an outline over the output bars
+    void drawInputSpectrum(const DrawArgs& args) {
+        const float* leftInput = engine->getLeftPreSpectrum();
+        const float* rightInput = engine->getRightPreSpectrum();
+        float innerX = 2.0f;
+        float innerY = 2.0f;
+        float innerWidth = box.size.x - 4.0f;
+        float innerHeight = box.size.y - 4.0f;
+        float barWidth = innerWidth / (float)EqAnalysisEngine::DISPLAY_BANDS;
+
+        nvgBeginPath(args.vg);
+        for (int i = 0; i < EqAnalysisEngine::DISPLAY_BANDS; i++) {
+            float height = std::max(leftInput[i], rightInput[i]) * (innerHeight - 2.0f) * 2.0f;
+            float y = (innerY + innerHeight) - clamp(height, 0.0f, innerHeight - 2.0f);
+            float x = innerX + i * barWidth;
+            if (i == 0) {
+                nvgMoveTo(args.vg, x, y);
+            } else {
+                nvgLineTo(args.vg, x, y);
+            }
+            nvgLineTo(args.vg, x + barWidth, y);
+        }
+        nvgStrokeColor(args.vg, nvgRGBA(150, 200, 255, 160));
+        nvgStrokeWidth(args.vg, 1.0f);
+        nvgStroke(args.vg);
+    }
+
     void draw(const DrawArgs& args) override {
+        // Publish the draw time so the module keeps analysing (Rack skips off-screen
+        // widgets and minimized windows; far zoomed out counts as not visible)
+        C1EQ* visibleModule = static_cast<C1EQ*>(module);
+        if (visibleModule && getAbsoluteZoom() >= MIN_VISIBLE_ZOOM) {
+            visibleModule->analyzerDrawTime.store(system::getTime(), std::memory_order_relaxed);
+        }
+
         drawBackground(args);
         drawSpectrum(args);
+        C1EQ* eq = static_cast<C1EQ*>(module);
+        if (eq && engine && eq->analyzerView == 1) {
+            drawInputSpectrum(args);
+        }
+        drawResponseCurve(args);
+        if (eq && engine && eq->analyzerView == 2) {
+            // Measured output / input on the EQ curve scale, to compare with the set curve
+            strokeCurve(args, engine->getDifferenceDb(), nvgRGBA(120, 230, 140, 220));
+        }
     }
 };
 
@@ -2055,6 +3462,7 @@ struct C1EQWidget : ModuleWidget {
             spectrumDisplay->module = module;
             spectrumDisplay->engine = module->spectrumAnalyzer;
             module->spectrumAnalyzer = new EqAnalysisEngine();
+            module->applyAnalyzerSettings();
             spectrumDisplay->engine = module->spectrumAnalyzer;
             addChild(spectrumDisplay);
 
@@ -2423,6 +3831,146 @@ struct C1EQWidget : ModuleWidget {
 
         menu->addChild(createBoolPtrMenuItem("Enable VCA Compression", "", &module->vcaCompressionEnabled));
         menu->addChild(createBoolPtrMenuItem("Enable Proportional Q", "", &module->enableProportionalQ));
+        menu->addChild(createBoolPtrMenuItem("Efficient Analog Mode (ADAA)", "", &module->efficientAnalogMode));
+        menu->addChild(createBoolPtrMenuItem("Matched HF Response (HMF/HF)", "", &module->matchedHighBands));
+
+        std::vector<std::string> sourceLabels = {"Sum of all channels"};
+        for (int c = 1; c <= C1EQ::MAX_CHANNELS; ++c) {
+            sourceLabels.push_back(string::f("Channel %d", c));
+        }
+        menu->addChild(createIndexPtrSubmenuItem("Analyzer Source", sourceLabels, &module->analyzerSource));
+        menu->addChild(createIndexSubmenuItem("Analyzer View", {"Output", "Input + Output", "EQ Difference"},
+            [=]() { return (size_t)module->analyzerView; },
+            [=](size_t index) { module->analyzerView = (int)index; module->applyAnalyzerSettings(); }));
+        menu->addChild(createBoolPtrMenuItem("Show EQ Curve", "", &module->showResponseCurve));
+
+        std::vector<std::string> fftSizeLabels;
+        for (int i = 0; i < EqAnalysisEngine::NUM_FFT_SIZES; ++i) {
+            fftSizeLabels.push_back(string::f("%d points", EqAnalysisEngine::fftSizeForIndex(i)));
+        }
+        menu->addChild(createIndexSubmenuItem("Analyzer FFT Size", fftSizeLabels,
+            [=]() { return (size_t)module->analyzerFFTSize; },
+            [=](size_t index) { module->analyzerFFTSize = (int)index; module->applyAnalyzerSettings(); }));
+        menu->addChild(createIndexSubmenuItem("Analyzer Window", {"Hann", "Blackman-Harris"},
+            [=]() { return (size_t)module->analyzerWindow; },
+            [=](size_t index) { module->analyzerWindow = (int)index; module->applyAnalyzerSettings(); }));
+        menu->addChild(createIndexSubmenuItem("Analyzer Overlap", {"None", "50%", "75%"},
+            [=]() { return (size_t)module->analyzerOverlap; },
+            [=](size_t index) { module->analyzerOverlap = (int)index; module->applyAnalyzerSettings(); }));
+        menu->addChild(createIndexSubmenuItem("Analyzer Smoothing",
+            {"Off (peak per band)", "1/3 octave", "1/6 octave", "1/12 octave"},
+            [=]() { return (size_t)module->analyzerSmoothing; },
+            [=](size_t index) { module->analyzerSmoothing = (int)index; module->applyAnalyzerSettings(); }));
+        menu->addChild(createBoolMenuItem("Analyzer Multirate (LF Detail)", "",
+            [=]() { return module->analyzerMultirate; },
+            [=](bool enabled) { module->analyzerMultirate = enabled; module->applyAnalyzerSettings(); }));
+        menu->addChild(createIndexSubmenuItem("Analyzer Averaging", {"Off", "Fast (100ms)", "Slow (500ms)"},
+            [=]() { return (size_t)module->analyzerAveraging; },
+            [=](size_t index) { module->analyzerAveraging = (int)index; module->applyAnalyzerSettings(); }));
+
+        // Dynamic EQ: band gain engages as the band-passed input rises above the threshold
+        menu->addChild(new MenuSeparator);
+        menu->addChild(createMenuLabel("Dynamic EQ"));
+
+        struct ThresholdQuantity : Quantity {
+            C1EQ* module;
+            int index;
+            std::string label;
+            ThresholdQuantity(C1EQ* m, int i, std::string l) : module(m), index(i), label(l) {}
+            void setValue(float value) override { module->dynamicThresholdDb[index] = clamp(value, -60.0f, 0.0f); }
+            float getValue() override { return module->dynamicThresholdDb[index]; }
+            float getMinValue() override { return -60.0f; }
+            float getMaxValue() override { return 0.0f; }
+            float getDefaultValue() override { return -20.0f; }
+            std::string getLabel() override { return label; }
+            std::string getUnit() override { return " dB"; }
+            int getDisplayPrecision() override { return 3; }
+        };
+        struct ThresholdSlider : ui::Slider {
+            ThresholdSlider(C1EQ* m, int i, std::string l) {
+                box.size.x = 200.0f;
+                quantity = new ThresholdQuantity(m, i, l);
+            }
+            ~ThresholdSlider() {
+                delete quantity;
+            }
+        };
+
+        const char* dynamicNames[2] = {"LMF", "HMF"};
+        for (int d = 0; d < 2; ++d) {
+            // Greyed out in linear-phase mode, where dynamic bands are ignored
+            menu->addChild(createBoolMenuItem(string::f("Dynamic %s", dynamicNames[d]), "",
+                [=]() { return module->dynamicEnabled[d]; },
+                [=](bool enabled) { module->dynamicEnabled[d] = enabled; },
+                module->linearPhaseEnabled.load()));
+            menu->addChild(new ThresholdSlider(module, d, string::f("%s Threshold", dynamicNames[d])));
+        }
+
+        // Mid/side: panel knobs set the mid bands, side bands are edited here
+        menu->addChild(new MenuSeparator);
+        menu->addChild(createBoolPtrMenuItem("Mid/Side Mode", "", &module->midSideMode));
+        menu->addChild(createSubmenuItem("Side Bands", "", [=](Menu* menu) {
+            // Slider over the module's own ParamQuantity (owned by the module, not deleted here)
+            struct SideParamSlider : ui::Slider {
+                SideParamSlider(C1EQ* m, int paramId) {
+                    box.size.x = 200.0f;
+                    quantity = m->paramQuantities[paramId];
+                }
+            };
+            auto modeItem = [=](const char* label, int paramId) {
+                return createIndexSubmenuItem(label, {"Shelf", "Bell", "Cut"},
+                    [=]() { return (size_t)std::round(module->params[paramId].getValue()); },
+                    [=](size_t mode) { module->params[paramId].setValue((float)mode); });
+            };
+
+            menu->addChild(modeItem("Side Low Mode", C1EQ::S_B1_MODE_PARAM));
+            for (int id = C1EQ::S_B1_FREQ_PARAM; id <= C1EQ::S_B4_GAIN_PARAM; ++id) {
+                menu->addChild(new SideParamSlider(module, id));
+            }
+            menu->addChild(modeItem("Side High Mode", C1EQ::S_B4_MODE_PARAM));
+
+            menu->addChild(new MenuSeparator);
+            menu->addChild(createMenuItem("Copy Mid to Side", "", [=]() {
+                for (int id = C1EQ::B1_FREQ_PARAM; id <= C1EQ::B4_MODE_PARAM; ++id) {
+                    module->params[id + C1EQ::SIDE_PARAM_OFFSET].setValue(module->params[id].getValue());
+                }
+            }));
+        }));
+
+        menu->addChild(new MenuSeparator);
+        menu->addChild(createIndexPtrSubmenuItem("Oversampling Factor",
+            {"Auto (by sample rate)", "2x", "4x", "8x"}, &module->oversamplingChoice));
+        // Filters only apply to the explicit 2x/4x/8x halfband cascade (greyed out in Auto)
+        menu->addChild(createIndexSubmenuItem("Oversampling Filters",
+            {"Short (lower CPU)", "Long (lower aliasing)"},
+            [=]() { return (size_t)module->oversamplingQuality; },
+            [=](size_t index) { module->oversamplingQuality = (int)index; },
+            module->oversamplingChoice == 0));
+
+        menu->addChild(new MenuSeparator);
+        menu->addChild(createBoolMenuItem("Linear Phase", "",
+            [=]() { return module->linearPhaseEnabled.load(); },
+            [=](bool enabled) { module->setLinearPhase(enabled); }));
+
+        std::vector<std::string> partitionLabels;
+        for (int i = 0; i < LinearPhaseEngine::NUM_PARTITION_SIZES; ++i) {
+            partitionLabels.push_back(string::f("%d samples", LinearPhaseEngine::partitionSizeForIndex(i)));
+        }
+        menu->addChild(createIndexSubmenuItem("Partition Size", partitionLabels,
+            [=]() {
+                int index = 0;
+                while (index < LinearPhaseEngine::NUM_PARTITION_SIZES - 1 &&
+                       LinearPhaseEngine::partitionSizeForIndex(index) < module->linearPhasePartition) {
+                    index++;
+                }
+                return (size_t)index;
+            },
+            [=](size_t index) { module->setLinearPhasePartition(LinearPhaseEngine::partitionSizeForIndex((int)index)); }));
+
+        // Latency of the FIR group delay plus one partition (Rack has no host latency compensation)
+        int latency = LinearPhaseEngine::LATENCY_TAPS + module->linearPhasePartition;
+        float sampleRate = APP->engine->getSampleRate();
+        menu->addChild(createMenuLabel(string::f("Latency: %d samples (%.1f ms)", latency, 1000.0f * latency / sampleRate)));
     }
 };
 
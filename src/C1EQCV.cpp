@@ -0,0 +1,248 @@
+#include "plugin.hpp"
+#include "../shared/include/TCLogo.hpp"
+#include <cmath>
+
+namespace {
+
+// Forward declaration for message struct (matches C1EQ.cpp definition)
+struct C1EQExpanderMessage {
+    float freqCV[4];  // Octaves (1V/oct, attenuated)
+    float gainCV[4];  // -1.0 to +1.0 (attenuated)
+    float qCV[4];     // -1.0 to +1.0 (attenuated, bands 2 & 3 only)
+};
+
+// Dark PJ301M port
+using DarkPJ301MPort = rack::componentlibrary::DarkPJ301MPort;
+
+// Custom TinySimpleLight with 20% outer glow (halo)
+template <typename TBase = rack::componentlibrary::YellowLight>
+struct TinySimpleLightHalf : rack::componentlibrary::TinySimpleLight<TBase> {
+    TinySimpleLightHalf() {
+        this->bgColor = nvgRGBA(0x33, 0x33, 0x33, 0x33); // 20% alpha
+        this->borderColor = nvgRGBA(0, 0, 0, 11);        // 20% alpha
+    }
+};
+
+struct C1EQCV : Module {
+    // Bands 1 & 4 have no Q control on C1-EQ, so they have no Q CV either
+    enum ParamIds {
+        ENUMS(FREQ_ATTEN_PARAM, 4),  // Frequency CV attenuverters (-1 to +1)
+        ENUMS(GAIN_ATTEN_PARAM, 4),  // Gain CV attenuverters (-1 to +1)
+        B2_Q_ATTEN_PARAM,            // Low-Mid Q CV attenuverter (-1 to +1)
+        B3_Q_ATTEN_PARAM,            // High-Mid Q CV attenuverter (-1 to +1)
+        PARAMS_LEN
+    };
+
+    enum InputIds {
+        ENUMS(FREQ_CV_INPUT, 4),
+        ENUMS(GAIN_CV_INPUT, 4),
+        B2_Q_CV_INPUT,
+        B3_Q_CV_INPUT,
+        INPUTS_LEN
+    };
+
+    // Attenuverter position lights: top, left, right per attenuverter (same order as ParamIds)
+    enum LightIds {
+        ENUMS(ATTEN_LIGHT, PARAMS_LEN * 3),
+        LIGHTS_LEN
+    };
+
+    // Message buffers for communication with C1-EQ
+    C1EQExpanderMessage leftMessages[2] = {};  // Double buffer for thread safety
+
+    // CV smoothing filters (1ms time constant to prevent zipper noise)
+    dsp::TExponentialFilter<float> cvFilters[INPUTS_LEN];
+
+    // Connection indicator fade (0.0 = white, 1.0 = amber)
+    float connectionFade = 0.0f;
+
+    dsp::ClockDivider lightDivider;
+
+    C1EQCV() {
+        config(PARAMS_LEN, INPUTS_LEN, 0, LIGHTS_LEN);
+
+        const char* bandNames[4] = {"Low", "Low-Mid", "High-Mid", "High"};
+
+        // Configure attenuverter parameters (bipolar -1 to +1, default 0%)
+        for (int i = 0; i < 4; ++i) {
+            configParam(FREQ_ATTEN_PARAM + i, -1.0f, 1.0f, 0.0f, string::f("%s Freq CV Amount", bandNames[i]), "%", 0.0f, 100.0f);
+            configParam(GAIN_ATTEN_PARAM + i, -1.0f, 1.0f, 0.0f, string::f("%s Gain CV Amount", bandNames[i]), "%", 0.0f, 100.0f);
+        }
+        configParam(B2_Q_ATTEN_PARAM, -1.0f, 1.0f, 0.0f, "Low-Mid Q CV Amount", "%", 0.0f, 100.0f);
+        configParam(B3_Q_ATTEN_PARAM, -1.0f, 1.0f, 0.0f, "High-Mid Q CV Amount", "%", 0.0f, 100.0f);
+
+        // Configure CV inputs
+        for (int i = 0; i < 4; ++i) {
+            configInput(FREQ_CV_INPUT + i, string::f("%s Freq CV (1V/oct)", bandNames[i]));
+            configInput(GAIN_CV_INPUT + i, string::f("%s Gain CV", bandNames[i]));
+        }
+        configInput(B2_Q_CV_INPUT, "Low-Mid Q CV");
+        configInput(B3_Q_CV_INPUT, "High-Mid Q CV");
+
+        // Initialize expander messages
+        leftExpander.producerMessage = &leftMessages[0];
+        leftExpander.consumerMessage = &leftMessages[1];
+
+        // Initialize CV smoothing filters (~1ms time constant)
+        for (int i = 0; i < INPUTS_LEN; ++i) {
+            cvFilters[i].setLambda(1000.0f);
+        }
+
+        lightDivider.setDivision(256);  // Update LEDs every 256 samples
+    }
+
+    // Smoothed, attenuated CV (0 when unpatched)
+    float readCV(int input, int atten, float sampleTime) {
+        if (!inputs[input].isConnected()) {
+            cvFilters[input].reset();
+            return 0.0f;
+        }
+        float smoothed = cvFilters[input].process(sampleTime, inputs[input].getVoltage());
+        return smoothed * params[atten].getValue();
+    }
+
+    void process(const ProcessArgs& args) override {
+        // Check if C1-EQ is connected to the left
+        if (leftExpander.module && leftExpander.module->model == modelC1EQ) {
+            // VCV Rack automatically points leftExpander.producerMessage to C1-EQ's consumerMessage
+            C1EQExpanderMessage* msg = (C1EQExpanderMessage*)leftExpander.producerMessage;
+
+            // Frequency: 1V/oct (attenuated); gain and Q: ±10V input → -1 to +1 (attenuated)
+            for (int i = 0; i < 4; ++i) {
+                msg->freqCV[i] = readCV(FREQ_CV_INPUT + i, FREQ_ATTEN_PARAM + i, args.sampleTime);
+                msg->gainCV[i] = readCV(GAIN_CV_INPUT + i, GAIN_ATTEN_PARAM + i, args.sampleTime) / 10.0f;
+            }
+            msg->qCV[0] = 0.0f;
+            msg->qCV[1] = readCV(B2_Q_CV_INPUT, B2_Q_ATTEN_PARAM, args.sampleTime) / 10.0f;
+            msg->qCV[2] = readCV(B3_Q_CV_INPUT, B3_Q_ATTEN_PARAM, args.sampleTime) / 10.0f;
+            msg->qCV[3] = 0.0f;
+
+            // Flip message buffers
+            leftExpander.messageFlipRequested = true;
+        }
+
+        // Smooth fade for connection indicator (200ms fade time)
+        bool isConnected = leftExpander.module && leftExpander.module->model == modelC1EQ;
+        float targetFade = isConnected ? 1.0f : 0.0f;
+        float fadeSpeed = 5.0f;  // 5 units/sec = 200ms fade
+        connectionFade += (targetFade - connectionFade) * fadeSpeed * args.sampleTime;
+
+        // Update attenuverter position lights (smooth fade between positions)
+        if (lightDivider.process()) {
+            for (int i = 0; i < PARAMS_LEN; ++i) {
+                float attenValue = params[i].getValue();
+                lights[ATTEN_LIGHT + i * 3 + 0].setBrightness(1.0f - std::abs(attenValue));
+                lights[ATTEN_LIGHT + i * 3 + 1].setBrightness(attenValue < 0.0f ? -attenValue : 0.0f);
+                lights[ATTEN_LIGHT + i * 3 + 2].setBrightness(attenValue > 0.0f ? attenValue : 0.0f);
+            }
+        }
+    }
+};
+
+// 8HP layout: one column per band (LF, LMF, HMF, HF), rows FREQ / GAIN / Q
+const float kColumnX[4] = {18.0f, 46.0f, 74.0f, 102.0f};
+const float kRowY[3] = {60.0f, 140.0f, 220.0f};
+
+struct C1EQCVWidget : ModuleWidget {
+    void addCVSection(C1EQCV* module, float x, float y, int inputId, int paramId) {
+        addInput(createInputCentered<DarkPJ301MPort>(Vec(x, y), module, inputId));
+        addParam(createParamCentered<Trimpot>(Vec(x, y + 43), module, paramId));
+        addChild(createLightCentered<TinySimpleLightHalf<YellowLight>>(Vec(x, y + 30.6f), module, C1EQCV::ATTEN_LIGHT + paramId * 3 + 0));
+        addChild(createLightCentered<TinySimpleLightHalf<YellowLight>>(Vec(x - 8.2f, y + 51.8f), module, C1EQCV::ATTEN_LIGHT + paramId * 3 + 1));
+        addChild(createLightCentered<TinySimpleLightHalf<YellowLight>>(Vec(x + 8.2f, y + 51.8f), module, C1EQCV::ATTEN_LIGHT + paramId * 3 + 2));
+    }
+
+    C1EQCVWidget(C1EQCV* module) {
+        setModule(module);
+        setPanel(createPanel(asset::plugin(pluginInstance, "res/C1EQCV.svg")));
+
+        // No screws - magnetic faceplate
+
+        // TC Logo (compact, centered for 8HP)
+        TCLogoWidget* tcLogo = new TCLogoWidget(TCLogoWidget::COMPACT, module);
+        tcLogo->box.pos = Vec(60, 355);
+        addChild(tcLogo);
+
+        // Title label rendered by code below
+
+        for (int band = 0; band < 4; ++band) {
+            addCVSection(module, kColumnX[band], kRowY[0], C1EQCV::FREQ_CV_INPUT + band, C1EQCV::FREQ_ATTEN_PARAM + band);
+            addCVSection(module, kColumnX[band], kRowY[1], C1EQCV::GAIN_CV_INPUT + band, C1EQCV::GAIN_ATTEN_PARAM + band);
+        }
+        addCVSection(module, kColumnX[1], kRowY[2], C1EQCV::B2_Q_CV_INPUT, C1EQCV::B2_Q_ATTEN_PARAM);
+        addCVSection(module, kColumnX[2], kRowY[2], C1EQCV::B3_Q_CV_INPUT, C1EQCV::B3_Q_ATTEN_PARAM);
+    }
+
+    // White text with black outline (matching other modules' style)
+    static void drawOutlinedText(NVGcontext* vg, float x, float y, const char* text) {
+        nvgFillColor(vg, nvgRGB(0x00, 0x00, 0x00));
+        for (int dx = -1; dx <= 1; dx++) {
+            for (int dy = -1; dy <= 1; dy++) {
+                if (dx != 0 || dy != 0) {
+                    nvgText(vg, x + dx * 0.5f, y + dy * 0.5f, text, NULL);
+                }
+            }
+        }
+        nvgFillColor(vg, nvgRGB(0xff, 0xff, 0xff));
+        nvgText(vg, x, y, text, NULL);
+    }
+
+    void draw(const DrawArgs& args) override {
+        ModuleWidget::draw(args);
+
+        // Draw title and labels (matching other modules' style)
+        std::shared_ptr<Font> sonoBold = APP->window->loadFont(asset::plugin(pluginInstance, "res/fonts/Sono/static/Sono_Proportional-Bold.ttf"));
+        std::shared_ptr<Font> sonoMedium = APP->window->loadFont(asset::plugin(pluginInstance, "res/fonts/Sono/static/Sono_Proportional-Medium.ttf"));
+
+        const float centerX = box.size.x / 2.0f;
+
+        // Title (EQ on first line, ·X· on second line) - Bold 18pt with black outline
+        nvgFontFaceId(args.vg, sonoBold->handle);
+        nvgFontSize(args.vg, 18.0f);
+        nvgTextAlign(args.vg, NVG_ALIGN_CENTER | NVG_ALIGN_MIDDLE);
+        drawOutlinedText(args.vg, centerX, 10, "EQ");
+
+        // "·X·" with smooth color fade on dots
+        float fade = module ? static_cast<C1EQCV*>(module)->connectionFade : 0.0f;
+
+        // Interpolate color from white (255,255,255) to amber (255,192,80)
+        uint8_t dotR = 255;
+        uint8_t dotG = (uint8_t)(255 - fade * (255 - 192));  // 255 → 192
+        uint8_t dotB = (uint8_t)(255 - fade * (255 - 80));   // 255 → 80
+        uint8_t dotA = (uint8_t)(255 - fade * 76);           // 255 → 179 (70% opacity)
+
+        // Black outline for dots
+        nvgFillColor(args.vg, nvgRGB(0x00, 0x00, 0x00));
+        for (int dx = -1; dx <= 1; dx++) {
+            for (int dy = -1; dy <= 1; dy++) {
+                if (dx != 0 || dy != 0) {
+                    nvgText(args.vg, centerX + dx * 0.5f, 30 + dy * 0.5f, "· ·", NULL);
+                }
+            }
+        }
+        // Colored dots with opacity fade
+        nvgFillColor(args.vg, nvgRGBA(dotR, dotG, dotB, dotA));
+        nvgText(args.vg, centerX, 30, "· ·", NULL);
+
+        // White X with black outline
+        drawOutlinedText(args.vg, centerX, 30, " X ");
+
+        // Band and parameter labels - Medium 9pt with black outline
+        nvgFontFaceId(args.vg, sonoMedium->handle);
+        nvgFontSize(args.vg, 9.0f);
+        nvgTextAlign(args.vg, NVG_ALIGN_CENTER | NVG_ALIGN_MIDDLE);
+
+        const char* bandLabels[4] = {"LF", "LMF", "HMF", "HF"};
+        for (int band = 0; band < 4; ++band) {
+            drawOutlinedText(args.vg, kColumnX[band], 44, bandLabels[band]);
+            drawOutlinedText(args.vg, kColumnX[band], kRowY[0] + 20, "FREQ");
+            drawOutlinedText(args.vg, kColumnX[band], kRowY[1] + 20, "GAIN");
+        }
+        drawOutlinedText(args.vg, kColumnX[1], kRowY[2] + 20, "Q");
+        drawOutlinedText(args.vg, kColumnX[2], kRowY[2] + 20, "Q");
+    }
+};
+
+} // namespace
+
+Model* modelC1EQCV = createModel<C1EQCV, C1EQCVWidget>("C1EQCV");
@@ -34,6 +34,7 @@ void init(Plugin* p) {
     // CV Expanders
     p->addModel(modelChanInCV);
     p->addModel(modelShapeCV);
+    p->addModel(modelC1EQCV);
     p->addModel(modelC1COMPCV);
     p->addModel(modelChanOutCV);
 }
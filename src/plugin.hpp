@@ -47,5 +47,6 @@ extern Model* modelChanOut;
 // CV Expanders
 extern Model* modelChanInCV;
 extern Model* modelShapeCV;
+extern Model* modelC1EQCV;
 extern Model* modelC1COMPCV;
 extern Model* modelChanOutCV;